@@ -84,6 +84,9 @@ void Error_Handler(void);
 #define DC_Pin_GPIO_Port GPIOA
 #define CS_Pin_Pin GPIO_PIN_4
 #define CS_Pin_GPIO_Port GPIOA
+#define EPD_Busy_Pin GPIO_PIN_0
+#define EPD_Busy_GPIO_Port GPIOB
+#define EPD_Busy_EXTI_IRQn EXTI0_IRQn
 #define Green_Led_Pin GPIO_PIN_3
 #define Green_Led_GPIO_Port GPIOB
 /* USER CODE BEGIN Private defines */
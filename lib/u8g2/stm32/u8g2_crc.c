@@ -0,0 +1,56 @@
+/*
+ * u8g2_crc.c
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: Władysław Ostrowski
+ */
+
+/*
+ This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "u8g2_io.h"
+
+/*
+ * Page signatures for MODE::SIGNED_PAGE: CRC-32 (polynomial 0x04C11DB7,
+ * init 0xFFFFFFFF, no reflection, no final XOR), the CRC peripheral's
+ * configuration from MX_CRC_Init(). Host builds (U8X8_HOST) compute the
+ * same value in software.
+ */
+
+#if !defined(U8X8_HOST)
+
+extern CRC_HandleTypeDef hcrc;
+
+uint32_t u8x8_crc32(const uint8_t *data, uint16_t len)
+{
+  return HAL_CRC_Calculate(&hcrc, (uint32_t *)data, len);
+}
+
+#else
+
+uint32_t u8x8_crc32(const uint8_t *data, uint16_t len)
+{
+  uint32_t crc = 0xFFFFFFFFU;
+  while (len-- > 0U)
+  {
+    crc ^= (uint32_t)*data++ << 24;
+    for (uint8_t bit = 0U; bit < 8U; bit++)
+      crc = (crc & 0x80000000U) ? (crc << 1) ^ 0x04C11DB7U : (crc << 1);
+  }
+  return crc;
+}
+
+#endif
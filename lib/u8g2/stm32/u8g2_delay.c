@@ -0,0 +1,93 @@
+/*
+ * u8g2_delay.c
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: Władysław Ostrowski
+ */
+
+/*
+ This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "u8g2_io.h"
+
+/*
+ * Busy-wait delays counted in core cycles with the DWT cycle counter.
+ * Conversions use the live SystemCoreClock, so they stay correct after
+ * the clock tree is reconfigured (as long as SystemCoreClockUpdate() or
+ * HAL_RCC_ClockConfig() kept it up to date).
+ * Host builds (U8X8_HOST, see test/) count on a virtual cycle counter
+ * instead: a delay advances it by its length, every read by one cycle, so
+ * timeouts still expire.
+ */
+
+#if defined(U8X8_HOST)
+
+static uint32_t host_cycles = 0U;
+
+void u8x8_delay_init(void)
+{
+}
+
+uint32_t u8x8_cycles(void)
+{
+  return host_cycles++;
+}
+
+void u8x8_delay_cycles(uint32_t cycles)
+{
+  host_cycles += cycles;
+}
+
+#else
+
+// enables the counter only, others (SwI2cBus, profiling) may be timing with it
+void u8x8_delay_init(void)
+{
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+uint32_t u8x8_cycles(void)
+{
+  return DWT->CYCCNT;
+}
+
+void u8x8_delay_cycles(uint32_t cycles)
+{
+  if ((DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) == 0U)
+    u8x8_delay_init();
+  const uint32_t start = DWT->CYCCNT;
+  while ((DWT->CYCCNT - start) < cycles)
+    ;
+}
+
+#endif
+
+void u8x8_delay_ns(uint32_t ns)
+{
+  // round up, a delay shorter than the datasheet asks for is a bug
+  u8x8_delay_cycles((ns * (SystemCoreClock / 1000000U) + 999U) / 1000U);
+}
+
+void u8x8_delay_us(uint32_t us)
+{
+  u8x8_delay_cycles(us * (SystemCoreClock / 1000000U));
+}
+
+void u8x8_delay_ms(uint32_t ms)
+{
+  while (ms-- > 0U)
+    u8x8_delay_cycles(SystemCoreClock / 1000U);
+}
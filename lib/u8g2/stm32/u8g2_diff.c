@@ -0,0 +1,160 @@
+/*
+ * u8g2_diff.c
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: Władysław Ostrowski
+ */
+
+/*
+ This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "u8g2_io.h"
+#include <string.h>
+
+/*
+ * Column-run transfers for SH1106/SSD1306 (MODE::DIFF_BUFFER). Each
+ * attached display has a copy of what its controller RAM holds.
+ * u8g2_diff_send() compares the frame buffer with it page by page,
+ * skipping equal stretches a word at a time, and sends only the changed
+ * column runs, each addressed with the same column high/low and page
+ * commands the u8g2 drivers use (so u8x8_byte_shadow can drop repeats).
+ *
+ * Re-addressing costs about as much as DIFF_MERGE_GAP data bytes, so runs
+ * closer than that are sent as one, unchanged bytes included.
+ */
+
+#define DIFF_MERGE_GAP 4U
+
+typedef struct
+{
+  u8g2_t *u8g2;
+  uint8_t valid;  // ram matches the controller
+  uint32_t ram[U8X8_DIFF_BUF_SIZE / 4U];
+} diff_t;
+
+static diff_t diff[U8X8_DIFF_SLOTS];
+
+static diff_t *diff_find(const u8g2_t *u8g2)
+{
+  for (uint8_t i = 0U; i < U8X8_DIFF_SLOTS; i++)
+  {
+    if (diff[i].u8g2 == u8g2)
+      return &diff[i];
+  }
+  return NULL;
+}
+
+void u8g2_diff_attach(u8g2_t *u8g2)
+{
+  diff_t *d = diff_find(u8g2);
+  const u8x8_display_info_t *info = u8g2_GetU8x8(u8g2)->display_info;
+  if (d == NULL)
+  {
+    if ((uint16_t)info->tile_width * info->tile_height * 8U > U8X8_DIFF_BUF_SIZE)
+      return;  // too big, sendBuffer sends whole frames
+    d = diff_find(NULL);
+    if (d == NULL)
+      return;
+    d->u8g2 = u8g2;
+  }
+  d->valid = 0U;
+}
+
+void u8g2_diff_invalidate(u8g2_t *u8g2)
+{
+  diff_t *d = diff_find(u8g2);
+  if (d != NULL)
+    d->valid = 0U;
+}
+
+static uint32_t diff_word(const uint8_t *p)
+{
+  uint32_t w;
+  memcpy(&w, p, sizeof(w));  // the u8g2 buffer has no alignment guarantee
+  return w;
+}
+
+// first column from col on where cur and old differ, width if none
+static uint16_t diff_next(const uint8_t *cur, const uint8_t *old, uint16_t col, uint16_t width)
+{
+  while (col + 4U <= width && diff_word(cur + col) == diff_word(old + col))
+    col += 4U;
+  while (col < width && cur[col] == old[col])
+    col++;
+  return col;
+}
+
+static void diff_run(u8x8_t *u8x8, uint8_t page, uint16_t col, uint16_t len, uint8_t *data)
+{
+  const uint16_t x = col + u8x8->x_offset;
+  u8x8_cad_SendCmd(u8x8, (uint8_t)(0x10U | (x >> 4)));
+  u8x8_cad_SendCmd(u8x8, (uint8_t)(x & 0x0FU));
+  u8x8_cad_SendCmd(u8x8, (uint8_t)(0xB0U | page));
+  while (len > 0U)
+  {
+    const uint8_t n = (len > 255U) ? 255U : (uint8_t)len;
+    u8x8_cad_SendData(u8x8, n, data);
+    data += n;
+    len -= n;
+  }
+}
+
+void u8g2_diff_send(u8g2_t *u8g2)
+{
+  diff_t *d = diff_find(u8g2);
+  u8x8_t *u8x8 = u8g2_GetU8x8(u8g2);
+  const uint16_t width = (uint16_t)u8x8->display_info->tile_width * 8U;
+  const uint8_t pages = u8x8->display_info->tile_height;
+
+  if (d == NULL)
+  {
+    u8g2_SendBuffer(u8g2);
+    return;
+  }
+  for (uint8_t page = 0U; page < pages; page++)
+  {
+    uint8_t *cur = u8g2->tile_buf_ptr + page * width;
+    uint8_t *old = (uint8_t *)d->ram + page * width;
+    uint8_t started = 0U;
+    uint16_t col = d->valid ? diff_next(cur, old, 0U, width) : 0U;
+
+    while (col < width)
+    {
+      uint16_t end = width;
+      if (d->valid)
+      {
+        // extend over changes that are closer than the cost of re-addressing
+        end = col + 1U;
+        for (uint16_t c = end; c < width && c - end < DIFF_MERGE_GAP; c++)
+        {
+          if (cur[c] != old[c])
+            end = c + 1U;
+        }
+      }
+      if (!started)
+      {
+        u8x8_cad_StartTransfer(u8x8);
+        started = 1U;
+      }
+      diff_run(u8x8, page, col, end - col, cur + col);
+      memcpy(old + col, cur + col, end - col);
+      col = diff_next(cur, old, end, width);
+    }
+    if (started)
+      u8x8_cad_EndTransfer(u8x8);
+  }
+  d->valid = 1U;
+}
@@ -0,0 +1,172 @@
+/*
+ * u8g2_dirty.c
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: Władysław Ostrowski
+ */
+
+/*
+ This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "u8g2_io.h"
+
+/*
+ * Dirty tile rectangle for full buffer displays. u8g2_dirty_attach() hooks
+ * ll_hvline, which every drawing call ends up in (pixels, boxes, glyphs,
+ * bitmaps), and grows a tile bounding box over what it touches.
+ * u8g2_dirty_send() pushes just that box with u8g2_UpdateDisplayArea().
+ * The first u8g2_dirty_send() attaches, so displays that never use it
+ * don't pay for the hook; with all slots taken it sends the whole buffer.
+ *
+ * Clearing the buffer doesn't draw, so u8g2_dirty_clear() adds the box of
+ * everything drawn since the previous clear: a value redrawn in place costs
+ * the tiles it covers, not the whole frame.
+ */
+
+typedef struct
+{
+  u8g2_t *u8g2;
+  u8g2_draw_ll_hvline_cb hvline;
+  u8g2_box_t dirty;  // to be sent
+  u8g2_box_t drawn;  // not blank since the last clear
+} dirty_t;
+
+static dirty_t dirty[U8X8_DIRTY_SLOTS];
+
+const u8g2_box_t u8g2_box_empty = { 0xFFU, 0xFFU, 0U, 0U };
+
+void u8g2_box_grow(u8g2_box_t *b, const u8g2_box_t *add)
+{
+  if (add->x0 > add->x1)
+    return;
+  if (b->x0 > b->x1)
+  {
+    *b = *add;
+    return;
+  }
+  if (add->x0 < b->x0) b->x0 = add->x0;
+  if (add->y0 < b->y0) b->y0 = add->y0;
+  if (add->x1 > b->x1) b->x1 = add->x1;
+  if (add->y1 > b->y1) b->y1 = add->y1;
+}
+
+// tiles touched by an ll_hvline call, clipped to the panel
+void u8g2_box_hvline(u8g2_box_t *b, const u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir)
+{
+  const u8x8_display_info_t *info = u8g2->u8x8.display_info;
+  u8g2_uint_t x1 = (dir == 0U) ? (u8g2_uint_t)(x + len - 1U) : x;
+  u8g2_uint_t y1 = (dir == 0U) ? y : (u8g2_uint_t)(y + len - 1U);
+
+  if (x1 >= info->pixel_width)
+    x1 = info->pixel_width - 1U;
+  if (y1 >= info->pixel_height)
+    y1 = info->pixel_height - 1U;
+  b->x0 = (uint8_t)(x >> 3);
+  b->y0 = (uint8_t)(y >> 3);
+  b->x1 = (uint8_t)(x1 >> 3);
+  b->y1 = (uint8_t)(y1 >> 3);
+}
+
+static dirty_t *dirty_find(const u8g2_t *u8g2)
+{
+  for (uint8_t i = 0U; i < U8X8_DIRTY_SLOTS; i++)
+  {
+    if (dirty[i].u8g2 == u8g2)
+      return &dirty[i];
+  }
+  return NULL;
+}
+
+static void dirty_hvline(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir)
+{
+  dirty_t *d = dirty_find(u8g2);
+  u8g2_box_t b;
+
+  u8g2_box_hvline(&b, u8g2, x, y, len, dir);
+  u8g2_box_grow(&d->dirty, &b);
+  u8g2_box_grow(&d->drawn, &b);
+  d->hvline(u8g2, x, y, len, dir);
+}
+
+void u8g2_dirty_attach(u8g2_t *u8g2)
+{
+  dirty_t *d = dirty_find(u8g2);
+  if (d == NULL)
+  {
+    d = dirty_find(NULL);
+    if (d == NULL)
+      return;  // out of slots, u8g2_dirty_send() sends the whole buffer
+    d->u8g2 = u8g2;
+  }
+  if (u8g2->ll_hvline != dirty_hvline)
+  {
+    // first attach, or the u8g2 was set up again since
+    d->hvline = u8g2->ll_hvline;
+    u8g2->ll_hvline = dirty_hvline;
+  }
+  u8g2_dirty_mark_all(u8g2);
+}
+
+void u8g2_dirty_mark_all(u8g2_t *u8g2)
+{
+  dirty_t *d = dirty_find(u8g2);
+  const u8x8_display_info_t *info = u8g2_GetU8x8(u8g2)->display_info;
+  if (d == NULL)
+    return;
+  d->dirty.x0 = 0U;
+  d->dirty.y0 = 0U;
+  d->dirty.x1 = (uint8_t)(info->tile_width - 1U);
+  d->dirty.y1 = (uint8_t)(info->tile_height - 1U);
+  d->drawn = d->dirty;
+}
+
+void u8g2_dirty_clear(u8g2_t *u8g2)
+{
+  dirty_t *d = dirty_find(u8g2);
+  u8g2_ClearBuffer(u8g2);
+  if (d == NULL)
+    return;
+  u8g2_box_grow(&d->dirty, &d->drawn);
+  d->drawn = u8g2_box_empty;
+}
+
+void u8g2_dirty_reset(u8g2_t *u8g2)
+{
+  dirty_t *d = dirty_find(u8g2);
+  if (d != NULL)
+    d->dirty = u8g2_box_empty;
+}
+
+void u8g2_dirty_send(u8g2_t *u8g2)
+{
+  dirty_t *d = dirty_find(u8g2);
+  if (d == NULL || u8g2->ll_hvline != dirty_hvline)
+  {
+    u8g2_dirty_attach(u8g2);
+    d = dirty_find(u8g2);
+    if (d == NULL)
+    {
+      u8g2_SendBuffer(u8g2);
+      return;
+    }
+  }
+  if (d->dirty.x0 > d->dirty.x1)
+    return;
+  u8g2_UpdateDisplayArea(u8g2, d->dirty.x0, d->dirty.y0,
+                         (uint8_t)(d->dirty.x1 - d->dirty.x0 + 1U),
+                         (uint8_t)(d->dirty.y1 - d->dirty.y0 + 1U));
+  d->dirty = u8g2_box_empty;
+}
@@ -0,0 +1,269 @@
+/*
+ * u8g2_epaper.c
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: Władysław Ostrowski
+ */
+
+/*
+ This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "u8g2_io.h"
+
+/*
+ * E-paper controllers (IL3820, SSD1606, SSD1607). u8g2's own refresh
+ * sequence polls the panel with delays for over a second; here the tiles
+ * inside the changed window are written, the update is activated and the
+ * call returns. The panel's BUSY line is on EXTI0 and drives the state
+ * below through u8g2_epaper_busy_isr(), which EXTI0_IRQHandler calls;
+ * HAL_GPIO_EXTI_Callback() is left to the application. u8g2_epaper_wait()
+ * sleeps in WFI until BUSY drops.
+ *
+ * u8g2_epaper_attach() hooks ll_hvline to grow a tile bounding box over
+ * everything drawn. The controller writes to one of two RAM images and
+ * shows the difference, so a partial send also repeats the previous
+ * window to bring the other image up to date.
+ *
+ * Controllers with a 30 byte LUT (IL3820, SSD1607) get the partial
+ * waveform for window updates and the full one back for
+ * u8g2_epaper_mark_all(); the others keep u8g2's LUT.
+ */
+
+#define EPD_CMD_LUT 0x32U
+#define EPD_CMD_UPDATE_CTRL 0x22U
+#define EPD_UPDATE_DISPLAY 0xC4U  // clock, analog, display pattern
+#define EPD_CMD_ACTIVATE 0x20U
+
+#define EPD_ACTIVATE_MS 100U   // activation to BUSY high, covers a queued DMA frame
+#define EPD_REFRESH_MS 5000U
+
+enum { EPD_IDLE, EPD_ACTIVATING, EPD_REFRESHING };
+enum { EPD_LUT_NONE, EPD_LUT_FULL, EPD_LUT_PARTIAL };
+
+static const uint8_t epd_lut_full[30] =
+{
+  0x02, 0x02, 0x01, 0x11, 0x12, 0x12, 0x22, 0x22, 0x66, 0x69,
+  0x69, 0x59, 0x58, 0x99, 0x99, 0x88, 0x00, 0x00, 0x00, 0x00,
+  0xF8, 0xB4, 0x13, 0x51, 0x35, 0x51, 0x51, 0x19, 0x01, 0x00
+};
+
+static const uint8_t epd_lut_partial[30] =
+{
+  0x10, 0x18, 0x18, 0x08, 0x18, 0x18, 0x08, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x13, 0x14, 0x44, 0x12, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+typedef struct
+{
+  u8g2_t *u8g2;
+  u8g2_draw_ll_hvline_cb hvline;
+  u8g2_box_t dirty;  // to be sent
+  u8g2_box_t drawn;  // not blank since the last clear
+  u8g2_box_t prev;   // last window sent, stale in the other RAM image
+  uint8_t has_lut;
+  uint8_t lut;      // waveform loaded in the controller
+  uint8_t full;     // next send is a full refresh of the whole panel
+} epaper_t;
+
+static epaper_t epaper[U8X8_EPAPER_SLOTS];
+static volatile uint8_t epd_state = EPD_IDLE;
+static volatile uint32_t epd_since;
+
+static epaper_t *epaper_find(const u8g2_t *u8g2)
+{
+  for (uint8_t i = 0U; i < U8X8_EPAPER_SLOTS; i++)
+  {
+    if (epaper[i].u8g2 == u8g2)
+      return &epaper[i];
+  }
+  return NULL;
+}
+
+static void epaper_hvline(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir)
+{
+  epaper_t *e = epaper_find(u8g2);
+  u8g2_box_t b;
+
+  u8g2_box_hvline(&b, u8g2, x, y, len, dir);
+  u8g2_box_grow(&e->dirty, &b);
+  u8g2_box_grow(&e->drawn, &b);
+  e->hvline(u8g2, x, y, len, dir);
+}
+
+static void epd_load_lut(u8x8_t *u8x8, epaper_t *e, uint8_t lut)
+{
+  if (!e->has_lut || e->lut == lut)
+    return;
+  u8x8_cad_StartTransfer(u8x8);
+  u8x8_cad_SendCmd(u8x8, EPD_CMD_LUT);
+  u8x8_cad_SendData(u8x8, sizeof(epd_lut_full),
+                    (uint8_t*)((lut == EPD_LUT_FULL) ? epd_lut_full : epd_lut_partial));
+  u8x8_cad_EndTransfer(u8x8);
+  e->lut = lut;
+}
+
+void u8g2_epaper_attach(u8g2_t *u8g2, uint8_t has_lut)
+{
+  epaper_t *e = epaper_find(u8g2);
+  if (e == NULL)
+  {
+    e = epaper_find(NULL);
+    if (e == NULL)
+      return;  // out of slots, sendBuffer goes through u8g2_SendBuffer
+    e->u8g2 = u8g2;
+  }
+  if (u8g2->ll_hvline != epaper_hvline)
+  {
+    // first attach, or the u8g2 was set up again since
+    e->hvline = u8g2->ll_hvline;
+    u8g2->ll_hvline = epaper_hvline;
+  }
+  e->has_lut = has_lut;
+  e->lut = EPD_LUT_NONE;
+  e->prev = u8g2_box_empty;
+  u8g2_epaper_mark_all(u8g2);
+}
+
+void u8g2_epaper_mark_all(u8g2_t *u8g2)
+{
+  epaper_t *e = epaper_find(u8g2);
+  const u8x8_display_info_t *info = u8g2_GetU8x8(u8g2)->display_info;
+  if (e == NULL)
+    return;
+  e->dirty.x0 = 0U;
+  e->dirty.y0 = 0U;
+  e->dirty.x1 = (uint8_t)(info->tile_width - 1U);
+  e->dirty.y1 = (uint8_t)(info->tile_height - 1U);
+  e->drawn = e->dirty;
+  e->full = 1U;
+}
+
+void u8g2_epaper_clear(u8g2_t *u8g2)
+{
+  epaper_t *e = epaper_find(u8g2);
+  u8g2_ClearBuffer(u8g2);
+  if (e == NULL)
+    return;
+  u8g2_box_grow(&e->dirty, &e->drawn);
+  e->drawn = u8g2_box_empty;
+}
+
+void u8g2_epaper_send(u8g2_t *u8g2)
+{
+  epaper_t *e = epaper_find(u8g2);
+  u8x8_t *u8x8 = u8g2_GetU8x8(u8g2);
+  const uint8_t stride = u8x8->display_info->tile_width;
+  u8g2_box_t win;
+
+  if (e == NULL)
+  {
+    u8g2_SendBuffer(u8g2);
+    return;
+  }
+  if (e->dirty.x0 > e->dirty.x1)
+    return;
+  win = e->dirty;
+  if (!e->full)
+    u8g2_box_grow(&win, &e->prev);
+
+  // commands sent while BUSY is high are ignored
+  u8g2_epaper_wait();
+  epd_load_lut(u8x8, e, e->full ? EPD_LUT_FULL : EPD_LUT_PARTIAL);
+  for (uint8_t ty = win.y0; ty <= win.y1; ty++)
+  {
+    u8x8_DrawTile(u8x8, win.x0, ty, (uint8_t)(win.x1 - win.x0 + 1U),
+                  u8g2->tile_buf_ptr + ((uint16_t)ty * stride + win.x0) * 8U);
+  }
+  u8x8_cad_StartTransfer(u8x8);
+  u8x8_cad_SendCmd(u8x8, EPD_CMD_UPDATE_CTRL);
+  u8x8_cad_SendArg(u8x8, EPD_UPDATE_DISPLAY);
+  u8x8_cad_SendCmd(u8x8, EPD_CMD_ACTIVATE);
+  u8x8_cad_EndTransfer(u8x8);
+
+  const uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  epd_state = EPD_ACTIVATING;
+  epd_since = HAL_GetTick();
+  __set_PRIMASK(primask);
+
+  e->prev = e->dirty;
+  e->dirty = u8g2_box_empty;
+  e->full = 0U;
+}
+
+// callable with interrupts already off, PRIMASK is put back as found
+uint8_t u8g2_epaper_is_busy(void)
+{
+  uint8_t busy = 1U;
+
+  const uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  const uint32_t elapsed = HAL_GetTick() - epd_since;
+  switch (epd_state)
+  {
+    case EPD_ACTIVATING:
+      if (elapsed < EPD_ACTIVATE_MS)
+        break;
+      if (HAL_GPIO_ReadPin(BUSY_GPIO_Port, BUSY_Pin) == GPIO_PIN_SET)
+      {
+        // rising edge missed, the refresh is on
+        epd_state = EPD_REFRESHING;
+        epd_since = HAL_GetTick();
+        break;
+      }
+      epd_state = EPD_IDLE;  // over already, or never started
+      busy = 0U;
+      break;
+    case EPD_REFRESHING:
+      if (elapsed < EPD_REFRESH_MS && HAL_GPIO_ReadPin(BUSY_GPIO_Port, BUSY_Pin) == GPIO_PIN_SET)
+        break;
+      if (elapsed >= EPD_REFRESH_MS)
+        u8x8_stats.timeouts++;
+      epd_state = EPD_IDLE;
+      busy = 0U;
+      break;
+    default:
+      busy = 0U;
+      break;
+  }
+  __set_PRIMASK(primask);
+  return busy;
+}
+
+void u8g2_epaper_wait(void)
+{
+  // SysTick wakes the core at least every millisecond for the timeouts
+  while (u8g2_epaper_is_busy())
+    __WFI();
+}
+
+// either edge of BUSY, from EXTI0_IRQHandler
+void u8g2_epaper_busy_isr(void)
+{
+  if (HAL_GPIO_ReadPin(BUSY_GPIO_Port, BUSY_Pin) == GPIO_PIN_SET)
+  {
+    if (epd_state == EPD_ACTIVATING)
+    {
+      epd_state = EPD_REFRESHING;
+      epd_since = HAL_GetTick();
+    }
+  }
+  else if (epd_state == EPD_REFRESHING)
+  {
+    epd_state = EPD_IDLE;
+  }
+}
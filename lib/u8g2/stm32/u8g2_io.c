@@ -21,33 +21,210 @@
 */
 
 #include "u8g2_io.h"
+#include <string.h>
 
 extern SPI_HandleTypeDef hspi1;
+extern I2C_HandleTypeDef hi2c1;
+extern UART_HandleTypeDef huart1;
+extern UART_HandleTypeDef huart2;
 
-uint8_t u8x8_byte_hw_spi(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+u8x8_stats_t u8x8_stats;
+static uint8_t stats_dc = 0U;
+
+void u8x8_stats_byte_msg(uint8_t msg, uint8_t arg_int)
 {
   switch(msg) {
     case U8X8_MSG_BYTE_SEND:
+      u8x8_stats.bytes += arg_int;
+      break;
+    case U8X8_MSG_BYTE_START_TRANSFER:
+      u8x8_stats.transfers++;
+      break;
+    case U8X8_MSG_BYTE_SET_DC:
+      if (arg_int != stats_dc)
+        u8x8_stats.dc_toggles++;
+      stats_dc = arg_int;
+      break;
+    default:
+      break;
+  }
+}
+
+// callable with interrupts already off, PRIMASK is put back as found
+void u8x8_stats_get(u8x8_stats_t *stats)
+{
+  const uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  *stats = u8x8_stats;
+  __set_PRIMASK(primask);
+}
+
+void u8x8_stats_reset(void)
+{
+  const uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  memset(&u8x8_stats, 0, sizeof(u8x8_stats));
+  __set_PRIMASK(primask);
+}
+
+/*
+ * Blocking SPI1 transmit straight through the TX FIFO. HAL_SPI_Transmit
+ * locks the handle, polls HAL_GetTick and waits for the bus to go idle on
+ * every call, which costs more than a 1-3 byte command takes on the wire.
+ * Here bytes are pushed in pairs (16-bit data packing) whenever TXE says
+ * the FIFO has room, and only u8x8_hw_spi_flush() waits for BSY, right
+ * before DC or CS change. SPE stays set from u8x8_hw_spi_init() on.
+ * Command bytes arrive one or two at a time and are collected in the arena
+ * first, so a DC run still goes out in one go.
+ */
+static uint8_t spi_arena[U8X8_SPI_ARENA_SIZE];
+static uint16_t spi_arena_len = 0U;
+static uint8_t spi_pending = 0U;   // FIFO may still hold data
+static uint8_t spi_dc = 0xFFU;     // DC level of this transfer, 0xFF before the first SET_DC
+
+static void spi_transmit(const uint8_t *data, uint16_t len)
+{
+  SPI_TypeDef *spi = hspi1.Instance;
+  const uint32_t start = u8x8_cycles();
+  while (len >= 2U)
+  {
+    while ((spi->SR & SPI_SR_TXE) == 0U)
+      ;
+    *(__IO uint16_t *)&spi->DR = (uint16_t)(data[0] | (data[1] << 8));
+    data += 2;
+    len -= 2U;
+  }
+  if (len > 0U)
+  {
+    while ((spi->SR & SPI_SR_TXE) == 0U)
+      ;
+    *(__IO uint8_t *)&spi->DR = *data;
+  }
+  spi_pending = 1U;
+  u8x8_stats.block_cycles += u8x8_cycles() - start;
+}
+
+// wait for the last bit, give up after ~1 ms so a dead bus can't hang the UI
+static void spi_drain(void)
+{
+  SPI_TypeDef *spi = hspi1.Instance;
+  const uint32_t start = u8x8_cycles();
+  const uint32_t limit = SystemCoreClock / 1000U;
+  while ((spi->SR & (SPI_SR_FTLVL | SPI_SR_BSY)) != 0U)
+  {
+    if (u8x8_cycles() - start > limit)
     {
-      uint8_t* data = (uint8_t *)arg_ptr;
-      HAL_SPI_Transmit(&hspi1, data, arg_int, 100);
+      u8x8_stats.timeouts++;
+      break;
     }
-     break;
+  }
+  // nobody reads RX in this mode
+  __HAL_SPI_CLEAR_OVRFLAG(&hspi1);
+  spi_pending = 0U;
+  u8x8_stats.block_cycles += u8x8_cycles() - start;
+}
+
+/*
+ * SCK follows the panel: the smallest SPI1 prescaler that keeps SCK at or
+ * below display_info->sck_clock_hz for the current APB2 clock. Called at
+ * the start of every transfer with the bus idle; it only touches CR1 when
+ * the display or PCLK2 changed since the last call. PCLK2 is what SPI1
+ * runs from, an APB2 prescaler change leaves SystemCoreClock as it was.
+ */
+void u8x8_hw_spi_clock(const u8x8_t *u8x8)
+{
+  static uint32_t sck_hz = 0U;
+  static uint32_t pclk_hz = 0U;
+  const uint32_t hz = u8x8->display_info->sck_clock_hz;
+  const uint32_t pclk = HAL_RCC_GetPCLK2Freq();
+  if (hz == sck_hz && pclk == pclk_hz)
+    return;
+  sck_hz = hz;
+  pclk_hz = pclk;
+
+  uint32_t br = 0U;  // SCK = pclk / 2^(br + 1)
+  while (br < 7U && (pclk >> (br + 1U)) > hz)
+    br++;
+  br <<= SPI_CR1_BR_Pos;
+  hspi1.Init.BaudRatePrescaler = br;
+
+  SPI_TypeDef *spi = hspi1.Instance;
+  const uint32_t cr1 = spi->CR1;
+  if ((cr1 & SPI_CR1_BR) == br)
+    return;
+  CLEAR_BIT(spi->CR1, SPI_CR1_SPE);
+  spi->CR1 = (cr1 & ~(SPI_CR1_BR | SPI_CR1_SPE)) | br;
+  spi->CR1 |= cr1 & SPI_CR1_SPE;
+}
+
+void u8x8_hw_spi_init(void)
+{
+  spi_arena_len = 0U;
+  __HAL_SPI_ENABLE(&hspi1);
+}
+
+void u8x8_hw_spi_flush(void)
+{
+  if (spi_arena_len > 0U)
+  {
+    spi_transmit(spi_arena, spi_arena_len);
+    spi_arena_len = 0U;
+  }
+  if (spi_pending)
+    spi_drain();
+}
+
+void u8x8_hw_spi_send(const uint8_t *data, uint8_t len)
+{
+  if (spi_arena_len + len > U8X8_SPI_ARENA_SIZE)
+  {
+    spi_transmit(spi_arena, spi_arena_len);
+    spi_arena_len = 0U;
+  }
+  if (len >= U8X8_SPI_ARENA_SIZE)
+  {
+    // page data is already contiguous, no point in copying it
+    spi_transmit(data, len);
+  }
+  else
+  {
+    memcpy(&spi_arena[spi_arena_len], data, len);
+    spi_arena_len += len;
+  }
+}
+
+uint8_t u8x8_byte_hw_spi(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  u8x8_stats_byte_msg(msg, arg_int);
+  switch(msg) {
+    case U8X8_MSG_BYTE_SEND:
+      u8x8_hw_spi_send((const uint8_t *)arg_ptr, arg_int);
+      break;
 
     case U8X8_MSG_BYTE_INIT:
+      u8x8_hw_spi_init();
       u8x8_gpio_SetCS(u8x8, u8x8->display_info->chip_disable_level);
       break;
 
     case U8X8_MSG_BYTE_SET_DC:
-      u8x8_gpio_SetDC(u8x8, arg_int);
+      // u8x8_cad_001 sets DC before every command byte, only a change ends the run
+      if (arg_int != spi_dc)
+      {
+        u8x8_hw_spi_flush();
+        u8x8_gpio_SetDC(u8x8, arg_int);
+        spi_dc = arg_int;
+      }
       break;
 
     case U8X8_MSG_BYTE_START_TRANSFER:
+      spi_dc = 0xFFU;
+      u8x8_hw_spi_clock(u8x8);
       u8x8_gpio_SetCS(u8x8, u8x8->display_info->chip_enable_level);
       u8x8->gpio_and_delay_cb(u8x8, U8X8_MSG_DELAY_NANO, u8x8->display_info->post_chip_enable_wait_ns, NULL);
       break;
 
     case U8X8_MSG_BYTE_END_TRANSFER:
+      u8x8_hw_spi_flush();
       u8x8->gpio_and_delay_cb(u8x8, U8X8_MSG_DELAY_NANO, u8x8->display_info->pre_chip_disable_wait_ns, NULL);
       u8x8_gpio_SetCS(u8x8, u8x8->display_info->chip_disable_level);
       break;
@@ -58,25 +235,400 @@ uint8_t u8x8_byte_hw_spi(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_p
   return 1;
 }
 
+/*
+ * Interrupt transport: u8x8 payloads go into a ring buffer which
+ * u8x8_hw_spi_it_isr() moves into the SPI1 TX FIFO on TXE. Every byte sent
+ * also shifts one in, so the ISR reads RX on RXNE and knows the bus is
+ * idle once as many bytes came back as went out; no more than the 4 byte
+ * RX FIFO is ever in flight, so nothing is lost to overrun. DC changes
+ * wait until the transfer so far is out; CS is released from the ISR once
+ * the last byte of a transfer is back, which completes the transfer.
+ */
+#define IT_IN_FLIGHT 4U
+
+static uint8_t it_ring[U8X8_IT_RING_SIZE];
+static volatile uint16_t it_head = 0U;
+static volatile uint16_t it_tail = 0U;
+static volatile uint8_t it_busy = 0U;
+static volatile uint8_t it_cs_release = 0U;
+static volatile uint32_t it_done = 0U;
+static uint8_t it_tx = 0U;   // bytes written to DR, ISR only
+static uint8_t it_rx = 0U;   // bytes read back from DR, ISR only
+static uint8_t it_dc = 0xFFU;
+static void (*it_done_cb)(void) = NULL;
+static u8x8_t *it_u8x8 = NULL;
+
+// drop what earlier transfers (or other transports) left in the RX FIFO, bus idle
+static void it_rx_flush(SPI_TypeDef *spi)
+{
+  while ((spi->SR & SPI_SR_FRLVL) != 0U)
+    (void)*(__IO uint8_t *)&spi->DR;
+  __HAL_SPI_CLEAR_OVRFLAG(&hspi1);
+  it_tx = 0U;
+  it_rx = 0U;
+}
+
+static void it_kick(void)
+{
+  SET_BIT(hspi1.Instance->CR2, SPI_CR2_TXEIE | SPI_CR2_RXNEIE);
+}
+
+uint8_t u8x8_hw_spi_it_is_busy(void)
+{
+  return it_busy;
+}
+
+void u8x8_hw_spi_it_wait(void)
+{
+  while (it_busy)
+    ;
+}
+
+uint32_t u8x8_hw_spi_it_transfers(void)
+{
+  return it_done;
+}
+
+void u8x8_hw_spi_it_on_complete(void (*cb)(void))
+{
+  it_done_cb = cb;
+}
+
+uint8_t u8x8_hw_spi_it_isr(void)
+{
+  SPI_TypeDef *spi = hspi1.Instance;
+  if ((spi->CR2 & (SPI_CR2_TXEIE | SPI_CR2_RXNEIE)) == 0U)
+    return 0U;
+
+  while ((spi->SR & SPI_SR_RXNE) != 0U)
+  {
+    (void)*(__IO uint8_t *)&spi->DR;
+    it_rx++;
+  }
+  while ((spi->SR & SPI_SR_TXE) != 0U && it_tail != it_head
+         && (uint8_t)(it_tx - it_rx) < IT_IN_FLIGHT)
+  {
+    *(__IO uint8_t *)&spi->DR = it_ring[it_tail];
+    it_tail = (it_tail + 1U) & (U8X8_IT_RING_SIZE - 1U);
+    it_tx++;
+  }
+  // TXE stays set while the FIFO has room, only listen when a byte may go in; RXNE reopens the window
+  if (it_tail != it_head && (uint8_t)(it_tx - it_rx) < IT_IN_FLIGHT)
+    SET_BIT(spi->CR2, SPI_CR2_TXEIE);
+  else
+    CLEAR_BIT(spi->CR2, SPI_CR2_TXEIE);
+  if (it_tail == it_head && it_tx == it_rx)
+  {
+    CLEAR_BIT(spi->CR2, SPI_CR2_RXNEIE);
+    if (it_cs_release)
+    {
+      it_cs_release = 0U;
+      it_u8x8->gpio_and_delay_cb(it_u8x8, U8X8_MSG_DELAY_NANO, it_u8x8->display_info->pre_chip_disable_wait_ns, NULL);
+      u8x8_gpio_SetCS(it_u8x8, it_u8x8->display_info->chip_disable_level);
+      it_done++;
+      if (it_done_cb != NULL)
+        it_done_cb();
+    }
+    it_busy = 0U;
+  }
+  return 1U;
+}
+
+uint8_t u8x8_byte_hw_spi_it(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  u8x8_stats_byte_msg(msg, arg_int);
+  switch(msg) {
+    case U8X8_MSG_BYTE_SEND:
+    {
+      const uint8_t* data = (const uint8_t *)arg_ptr;
+      while (arg_int-- > 0U)
+      {
+        const uint16_t next = (it_head + 1U) & (U8X8_IT_RING_SIZE - 1U);
+        if (next == it_tail)
+        {
+          it_kick();
+          while (next == it_tail)
+            ;
+        }
+        it_ring[it_head] = *data++;
+        it_head = next;
+        it_busy = 1U;
+      }
+      it_kick();
+    }
+     break;
+
+    case U8X8_MSG_BYTE_INIT:
+      it_u8x8 = u8x8;
+      u8x8_hw_spi_it_wait();
+      SET_BIT(hspi1.Instance->CR2, SPI_CR2_FRXTH);  // RXNE per byte
+      __HAL_SPI_ENABLE(&hspi1);
+      u8x8_gpio_SetCS(u8x8, u8x8->display_info->chip_disable_level);
+      break;
+
+    case U8X8_MSG_BYTE_SET_DC:
+      // u8x8_cad_001 sets DC before every command byte, only a change has to wait
+      if (arg_int != it_dc)
+      {
+        u8x8_hw_spi_it_wait();
+        u8x8_gpio_SetDC(u8x8, arg_int);
+        it_dc = arg_int;
+      }
+      break;
+
+    case U8X8_MSG_BYTE_START_TRANSFER:
+      u8x8_hw_spi_it_wait();
+      it_u8x8 = u8x8;
+      it_dc = 0xFFU;
+      it_rx_flush(hspi1.Instance);
+      u8x8_hw_spi_clock(u8x8);
+      u8x8_gpio_SetCS(u8x8, u8x8->display_info->chip_enable_level);
+      u8x8->gpio_and_delay_cb(u8x8, U8X8_MSG_DELAY_NANO, u8x8->display_info->post_chip_enable_wait_ns, NULL);
+      break;
+
+    case U8X8_MSG_BYTE_END_TRANSFER:
+      __disable_irq();
+      if (it_busy)
+      {
+        it_cs_release = 1U;
+        __enable_irq();
+      }
+      else
+      {
+        __enable_irq();
+        u8x8->gpio_and_delay_cb(u8x8, U8X8_MSG_DELAY_NANO, u8x8->display_info->pre_chip_disable_wait_ns, NULL);
+        u8x8_gpio_SetCS(u8x8, u8x8->display_info->chip_disable_level);
+        it_done++;
+        if (it_done_cb != NULL)
+          it_done_cb();
+      }
+      break;
+
+    default:
+      return 0;
+  }
+  return 1;
+}
+
+/*
+ * Hardware I2C transport. Each START/END pair is one I2C write with DMA.
+ * While a write is on the bus the next one is built in the second buffer;
+ * consecutive 0x40 (data) writes to the same address are merged there,
+ * dropping the repeated control byte, so a page goes out in few large
+ * transfers instead of u8g2's 25-byte chunks.
+ */
+typedef struct
+{
+  uint8_t data[U8X8_I2C_BUF_SIZE];
+  volatile uint16_t len;
+  uint8_t addr;
+} i2c_buf_t;
+
+static i2c_buf_t i2c_buf[2];
+static i2c_buf_t *volatile i2c_active = &i2c_buf[0];
+static i2c_buf_t *volatile i2c_pending = &i2c_buf[1];
+static volatile uint8_t i2c_pending_closed = 0U;
+static volatile uint8_t i2c_busy = 0U;
+static uint8_t i2c_first = 0U;
+
+// called with interrupts disabled or from the I2C interrupts
+static void i2c_start_pending(void)
+{
+  if (i2c_busy || !i2c_pending_closed || i2c_pending->len == 0U)
+    return;
+  i2c_buf_t *b = i2c_pending;
+  i2c_pending = i2c_active;
+  i2c_pending->len = 0U;
+  i2c_pending_closed = 0U;
+  i2c_active = b;
+  i2c_busy = 1U;
+  if (HAL_I2C_Master_Transmit_DMA(&hi2c1, b->addr, b->data, b->len) != HAL_OK)
+    i2c_busy = 0U;
+}
+
+uint8_t u8x8_hw_i2c_is_busy(void)
+{
+  return i2c_busy || i2c_pending->len != 0U;
+}
+
+void u8x8_hw_i2c_wait(void)
+{
+  while (u8x8_hw_i2c_is_busy())
+    ;
+}
+
+uint8_t u8x8_byte_hw_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  u8x8_stats_byte_msg(msg, arg_int);
+  switch(msg) {
+    case U8X8_MSG_BYTE_SEND:
+    {
+      const uint8_t* data = (const uint8_t *)arg_ptr;
+      if (i2c_first && arg_int > 0U)
+      {
+        i2c_first = 0U;
+        const uint8_t addr = u8x8_GetI2CAddress(u8x8);
+        __disable_irq();
+        if (i2c_pending_closed && i2c_pending->len != 0U && i2c_pending->addr == addr
+            && i2c_pending->data[0] == 0x40U && data[0] == 0x40U)
+        {
+          // reopen the queued data write and continue it
+          i2c_pending_closed = 0U;
+          __enable_irq();
+          data++;
+          arg_int--;
+        }
+        else
+        {
+          __enable_irq();
+          while (i2c_pending->len != 0U)
+            ;
+          i2c_pending->addr = addr;
+        }
+      }
+      while (arg_int > 0U)
+      {
+        if (i2c_pending->len == U8X8_I2C_BUF_SIZE)
+        {
+          // only merged data writes get here, split them into a new write
+          __disable_irq();
+          i2c_pending_closed = 1U;
+          i2c_start_pending();
+          __enable_irq();
+          while (i2c_pending->len != 0U)
+            ;
+          i2c_pending->addr = u8x8_GetI2CAddress(u8x8);
+          i2c_pending->data[i2c_pending->len++] = 0x40U;
+        }
+        i2c_pending->data[i2c_pending->len++] = *data++;
+        arg_int--;
+      }
+    }
+      break;
+
+    case U8X8_MSG_BYTE_INIT:
+      break;
+
+    case U8X8_MSG_BYTE_SET_DC:
+      break;
+
+    case U8X8_MSG_BYTE_START_TRANSFER:
+      i2c_first = 1U;
+      break;
+
+    case U8X8_MSG_BYTE_END_TRANSFER:
+      __disable_irq();
+      i2c_pending_closed = 1U;
+      i2c_start_pending();
+      __enable_irq();
+      break;
+
+    default:
+      return 0;
+  }
+  return 1;
+}
+
+static void i2c_done(void)
+{
+  i2c_busy = 0U;
+  i2c_start_pending();
+}
+
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+  if (hi2c == &hi2c1)
+    i2c_done();
+}
+
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+  if (hi2c == &hi2c1)
+  {
+    u8x8_stats.errors++;
+    i2c_done();
+  }
+}
+
+/*
+ * CS, DC and RESET follow u8x8->pins[] so several displays can share one
+ * bus (see U8X8_GPIO_PIN). Unset pins fall back to the board wiring on GPIOA.
+ */
+void u8x8_gpio_init_pin(uint8_t pin)
+{
+  if (pin == U8X8_PIN_NONE)
+    return;
+  GPIO_InitTypeDef init = {0};
+  init.Pin = U8X8_GPIO_MASK(pin);
+  init.Mode = GPIO_MODE_OUTPUT_PP;
+  init.Pull = GPIO_NOPULL;
+  init.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+  HAL_GPIO_Init(U8X8_GPIO_PORT(pin), &init);
+}
+
+// MX_USART1/2_UART_Init leave PA9/PA10 and PA2/PA15 in their AF; a bus that
+// reuses them stops the USART first so it cannot drive TX into the data lines
+void u8x8_gpio_release_uart(GPIO_TypeDef *port, uint32_t mask)
+{
+  if (port != GPIOA)
+    return;
+  if ((mask & (GPIO_PIN_9 | GPIO_PIN_10)) != 0U && huart1.Instance != NULL)
+    HAL_UART_DeInit(&huart1);
+  if ((mask & (GPIO_PIN_2 | GPIO_PIN_15)) != 0U && huart2.Instance != NULL)
+    HAL_UART_DeInit(&huart2);
+}
+
+// open-drain, so a set bit releases the line to the pull-up
+static void swi2c_init_pins(void)
+{
+  GPIO_InitTypeDef init = {0};
+  SWI2C_GPIO_Port->BSRR = SWI2C_SCL_Pin | SWI2C_SDA_Pin;
+  init.Pin = SWI2C_SCL_Pin | SWI2C_SDA_Pin;
+  init.Mode = GPIO_MODE_OUTPUT_OD;
+  init.Pull = GPIO_PULLUP;
+  init.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+  HAL_GPIO_Init(SWI2C_GPIO_Port, &init);
+}
+
+static void gpio_write(uint8_t pin, uint16_t board_pin, uint8_t level)
+{
+  GPIO_TypeDef *port = GPIOA;
+  uint32_t mask = board_pin;
+  if (pin != U8X8_PIN_NONE)
+  {
+    port = U8X8_GPIO_PORT(pin);
+    mask = U8X8_GPIO_MASK(pin);
+  }
+  port->BSRR = level ? mask : (mask << 16);
+}
+
 uint8_t u8x8_gpio_and_delay(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
 {
   switch(msg)
   {
     case U8X8_MSG_GPIO_AND_DELAY_INIT:  // called once during init phase of u8g2/u8x8
-      break;                            // can be used to setup pins
+      u8x8_delay_init();                // can be used to setup pins
+      u8x8_gpio_init_pin(u8x8->pins[U8X8_PIN_CS]);
+      u8x8_gpio_init_pin(u8x8->pins[U8X8_PIN_DC]);
+      u8x8_gpio_init_pin(u8x8->pins[U8X8_PIN_RESET]);
+      if (u8x8->byte_cb == u8x8_byte_sw_i2c)
+        swi2c_init_pins();
+      break;
     case U8X8_MSG_DELAY_NANO:           // delay arg_int * 1 nano second
+      u8x8_delay_ns(arg_int);
       break;
     case U8X8_MSG_DELAY_100NANO:        // delay arg_int * 100 nano seconds
-        __NOP();
+      u8x8_delay_ns(arg_int * 100U);
       break;
     case U8X8_MSG_DELAY_10MICRO:        // delay arg_int * 10 micro seconds
-      HAL_Delay(1);
+      u8x8_delay_us(arg_int * 10U);
       break;
     case U8X8_MSG_DELAY_MILLI:          // delay arg_int * 1 milli second
-      HAL_Delay(arg_int);
+      u8x8_delay_ms(arg_int);
       break;
     case U8X8_MSG_DELAY_I2C:                // arg_int is the I2C speed in 100KHz, e.g. 4 = 400 KHz
-      break;                            // arg_int=1: delay by 5us, arg_int = 4: delay by 1.25us
+      u8x8_delay_ns(5000U / (arg_int ? arg_int : 1U)); // arg_int=1: delay by 5us, arg_int = 4: delay by 1.25us
+      break;
 //    case U8X8_MSG_GPIO_D0:              // D0 or SPI clock pin: Output level in arg_int
     case U8X8_MSG_GPIO_SPI_CLOCK:
         if (arg_int) HAL_GPIO_WritePin(GPIOA, CLK_Pin, GPIO_PIN_SET);
@@ -102,18 +654,15 @@ uint8_t u8x8_gpio_and_delay(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *ar
     case U8X8_MSG_GPIO_E:               // E/WR pin: Output level in arg_int
       break;
     case U8X8_MSG_GPIO_CS:              // CS (chip select) pin: Output level in arg_int
-        if (arg_int) HAL_GPIO_WritePin(GPIOA, CS_Pin, GPIO_PIN_SET);
-        else HAL_GPIO_WritePin(GPIOA, CS_Pin, GPIO_PIN_RESET);
+        gpio_write(u8x8->pins[U8X8_PIN_CS], CS_Pin, arg_int);
         break;
 
     case U8X8_MSG_GPIO_DC:              // DC (data/cmd, A0, register select) pin: Output level in arg_int
-        if (arg_int) HAL_GPIO_WritePin(GPIOA, DC_Pin, GPIO_PIN_SET);
-        else HAL_GPIO_WritePin(GPIOA, DC_Pin, GPIO_PIN_RESET);
+        gpio_write(u8x8->pins[U8X8_PIN_DC], DC_Pin, arg_int);
         break;
 
     case U8X8_MSG_GPIO_RESET:           // Reset pin: Output level in arg_int
-        if (arg_int) HAL_GPIO_WritePin(GPIOA, RST_Pin, GPIO_PIN_SET);
-        else HAL_GPIO_WritePin(GPIOA, RST_Pin, GPIO_PIN_RESET);
+        gpio_write(u8x8->pins[U8X8_PIN_RESET], RST_Pin, arg_int);
         break;
 
     case U8X8_MSG_GPIO_CS1:             // CS1 (chip select) pin: Output level in arg_int
@@ -121,9 +670,11 @@ uint8_t u8x8_gpio_and_delay(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *ar
     case U8X8_MSG_GPIO_CS2:             // CS2 (chip select) pin: Output level in arg_int
       break;
     case U8X8_MSG_GPIO_I2C_CLOCK:       // arg_int=0: Output low at I2C clock pin
-      break;                            // arg_int=1: Input dir with pullup high for I2C clock pin
+        SWI2C_GPIO_Port->BSRR = arg_int ? SWI2C_SCL_Pin : ((uint32_t)SWI2C_SCL_Pin << 16);
+        break;                          // arg_int=1: Input dir with pullup high for I2C clock pin
     case U8X8_MSG_GPIO_I2C_DATA:            // arg_int=0: Output low at I2C data pin
-      break;                            // arg_int=1: Input dir with pullup high for I2C data pin
+        SWI2C_GPIO_Port->BSRR = arg_int ? SWI2C_SDA_Pin : ((uint32_t)SWI2C_SDA_Pin << 16);
+        break;                          // arg_int=1: Input dir with pullup high for I2C data pin
     case U8X8_MSG_GPIO_MENU_SELECT:
       u8x8_SetGPIOResult(u8x8, /* get menu select pin state */ 0);
       break;
@@ -37,8 +37,151 @@
 #define DC_Pin GPIO_PIN_3
 #define CS_Pin GPIO_PIN_4
 
+// 8080/6800 parallel bus, all on GPIOA; takes over the USART1 (PA9, PA10) and
+// USART2 (PA2, PA15) pins, ParallelBus::init de-initialises both UARTs
+#define PAR_D0_Pin GPIO_PIN_5
+#define PAR_D1_Pin GPIO_PIN_6
+#define PAR_D2_Pin GPIO_PIN_8
+#define PAR_D3_Pin GPIO_PIN_9
+#define PAR_D4_Pin GPIO_PIN_10
+#define PAR_D5_Pin GPIO_PIN_11
+#define PAR_D6_Pin GPIO_PIN_12
+#define PAR_D7_Pin GPIO_PIN_15
+#define PAR_WR_Pin GPIO_PIN_2   // WR (8080) or E (6800)
+
+// e-paper BUSY, EXTI0 both edges (MX_GPIO_Init)
+#define BUSY_Pin GPIO_PIN_0
+#define BUSY_GPIO_Port GPIOB
+
+// software I2C, open-drain
+#define SWI2C_SCL_Pin GPIO_PIN_4
+#define SWI2C_SDA_Pin GPIO_PIN_5
+#define SWI2C_GPIO_Port GPIOB
+
+// u8x8 pin number (u8x8_SetPin) for pin n of a GPIO port, e.g. U8X8_GPIO_PIN(GPIOB_BASE, 5)
+#define U8X8_GPIO_PIN(port_base, n) ((uint8_t)(((((port_base) - GPIOA_BASE) / 0x400U) << 4) | (n)))
+#define U8X8_GPIO_PORT(pin) ((GPIO_TypeDef *)(GPIOA_BASE + ((pin) >> 4) * 0x400U))
+#define U8X8_GPIO_MASK(pin) (1U << ((pin) & 0x0FU))
+
+#define U8X8_SPI_ARENA_SIZE 32U
+#define U8X8_BUS_SLOTS 8U        // queued segments on the shared SPI bus
+#define U8X8_BUS_SLOT_SIZE 128U
+#define U8X8_FRAME_BUF_SIZE 1152U // recorded frame: 128x64 data + per-page commands, larger lent frames are referenced
+#define U8X8_FRAME_RUNS 40U       // DC/CS runs per recording, 2 per page of a full frame
+#define U8X8_SHADOW_SLOTS 4U     // displays with a controller state shadow
+#define U8X8_MEMLCD_SLOTS 2U     // Sharp memory LCDs with dirty line tracking
+#define U8X8_MEMLCD_LINES 240U
+#define U8X8_EPAPER_SLOTS 2U     // e-paper panels with window tracking
+#define U8X8_DIRTY_SLOTS 4U      // full buffer displays with a dirty rectangle
+#define U8X8_DIFF_SLOTS 1U       // DIFF_BUFFER displays, each with a RAM copy
+#define U8X8_DIFF_BUF_SIZE 1024U // 128x64
+#define U8X8_3W_BUF_FRAMES 128U  // 9-bit frames per 3-wire DMA buffer
+#define U8X8_IT_RING_SIZE 256U  // power of two
+#define U8X8_I2C_BUF_SIZE 1025U // control byte + 128x64 frame
+
+/*
+ * Transport counters, cumulative since reset. Byte callbacks feed them
+ * through u8x8_stats_byte_msg(); the blocking SPI path adds its time.
+ */
+typedef struct
+{
+  uint32_t bytes;         // payload bytes handed to the transport
+  uint32_t transfers;     // START_TRANSFER count
+  uint32_t dc_toggles;    // SET_DC that changed the level
+  uint32_t block_cycles;  // core cycles spent in blocking SPI transmits
+  uint32_t timeouts;      // bus waits given up: SPI never idle, I2C clock held low
+  uint32_t errors;        // SPI/I2C error callbacks, DMA starts the HAL refused
+  uint32_t elided;        // command bytes dropped by the controller shadow
+} u8x8_stats_t;
+
+extern u8x8_stats_t u8x8_stats;
+void u8x8_stats_byte_msg(uint8_t, uint8_t);
+void u8x8_stats_get(u8x8_stats_t*);
+void u8x8_stats_reset(void);
+
 uint8_t u8x8_byte_hw_spi(u8x8_t*, uint8_t, uint8_t, void*);
+void u8x8_hw_spi_init(void);
+void u8x8_hw_spi_clock(const u8x8_t*);
+void u8x8_hw_spi_send(const uint8_t*, uint8_t);
+void u8x8_hw_spi_flush(void);
 uint8_t u8x8_gpio_and_delay(u8x8_t*, uint8_t, uint8_t, void*);
+void u8x8_gpio_init_pin(uint8_t);
+void u8x8_gpio_release_uart(GPIO_TypeDef*, uint32_t);
+
+void u8x8_delay_init(void);
+uint32_t u8x8_cycles(void);
+void u8x8_delay_cycles(uint32_t);
+void u8x8_delay_ns(uint32_t);
+void u8x8_delay_us(uint32_t);
+void u8x8_delay_ms(uint32_t);
+
+uint8_t u8x8_byte_hw_spi_dma(u8x8_t*, uint8_t, uint8_t, void*);
+uint8_t u8x8_hw_spi_dma_is_busy(void);
+void u8x8_hw_spi_dma_wait(void);
+void u8x8_hw_spi_dma_lend(const uint8_t*, uint16_t);
+uint32_t u8x8_hw_spi_dma_ticket(void);
+void u8x8_hw_spi_dma_frame_begin(void);
+uint32_t u8x8_hw_spi_dma_frame_end(void);
+void u8x8_hw_spi_dma_wait_ticket(uint32_t);
+uint8_t u8x8_hw_spi_dma_done(uint32_t);
+void u8x8_hw_spi_dma_fill_begin(uint8_t);
+void u8x8_hw_spi_dma_fill_end(void);
+
+uint8_t u8x8_byte_hw_spi_3w(u8x8_t*, uint8_t, uint8_t, void*);
+uint8_t u8x8_hw_spi_3w_done(SPI_HandleTypeDef*);
+uint8_t u8x8_hw_spi_3w_is_busy(void);
+void u8x8_hw_spi_3w_wait(void);
+
+uint8_t u8x8_byte_hw_spi_it(u8x8_t*, uint8_t, uint8_t, void*);
+uint8_t u8x8_hw_spi_it_isr(void);
+uint8_t u8x8_hw_spi_it_is_busy(void);
+void u8x8_hw_spi_it_wait(void);
+uint32_t u8x8_hw_spi_it_transfers(void);
+void u8x8_hw_spi_it_on_complete(void (*)(void));
+
+uint8_t u8x8_byte_shadow(u8x8_t*, uint8_t, uint8_t, void*);
+void u8x8_shadow_attach(u8x8_t*, uint8_t, uint8_t);
+void u8x8_shadow_invalidate(u8x8_t*);
+
+void u8g2_memlcd_attach(u8g2_t*);
+void u8g2_memlcd_mark_all(u8g2_t*);
+void u8g2_memlcd_clear(u8g2_t*);
+void u8g2_memlcd_send(u8g2_t*);
+void u8g2_memlcd_vcom_start(void);
+
+void u8g2_epaper_attach(u8g2_t*, uint8_t);
+void u8g2_epaper_mark_all(u8g2_t*);
+void u8g2_epaper_clear(u8g2_t*);
+void u8g2_epaper_send(u8g2_t*);
+uint8_t u8g2_epaper_is_busy(void);
+void u8g2_epaper_wait(void);
+void u8g2_epaper_busy_isr(void);
+
+// tile rectangle, inclusive, empty while x0 > x1 (u8g2_dirty.c)
+typedef struct
+{
+  uint8_t x0, y0, x1, y1;
+} u8g2_box_t;
+
+extern const u8g2_box_t u8g2_box_empty;
+void u8g2_box_grow(u8g2_box_t*, const u8g2_box_t*);
+void u8g2_box_hvline(u8g2_box_t*, const u8g2_t*, u8g2_uint_t, u8g2_uint_t, u8g2_uint_t, uint8_t);
+
+void u8g2_dirty_attach(u8g2_t*);
+void u8g2_dirty_mark_all(u8g2_t*);
+void u8g2_dirty_clear(u8g2_t*);
+void u8g2_dirty_reset(u8g2_t*);
+void u8g2_dirty_send(u8g2_t*);
+
+uint32_t u8x8_crc32(const uint8_t*, uint16_t);
+
+void u8g2_diff_attach(u8g2_t*);
+void u8g2_diff_invalidate(u8g2_t*);
+void u8g2_diff_send(u8g2_t*);
+
+uint8_t u8x8_byte_hw_i2c(u8x8_t*, uint8_t, uint8_t, void*);
+uint8_t u8x8_hw_i2c_is_busy(void);
+void u8x8_hw_i2c_wait(void);
 
 
 #ifdef __cplusplus
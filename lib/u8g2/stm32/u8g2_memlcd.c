@@ -0,0 +1,160 @@
+/*
+ * u8g2_memlcd.c
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: Władysław Ostrowski
+ */
+
+/*
+ This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "u8g2_io.h"
+#include <string.h>
+
+extern TIM_HandleTypeDef htim1;
+
+/*
+ * Sharp memory LCDs (LS013B7DH03, LS027B7DH01) take whole scanlines, each
+ * addressed by its line number, and keep the image without refresh.
+ * u8g2_memlcd_attach() hooks u8g2's ll_hvline to mark the lines a draw call
+ * touches; u8g2_memlcd_send() then writes only the marked lines, all of
+ * them in one CS-high burst:
+ *
+ *   mode (M0 = write) | { address | line data | dummy } ... | dummy
+ *
+ * clearBuffer only re-sends lines that had content, so a frame redrawn in
+ * the same place costs exactly the lines that were drawn.
+ *
+ * The panels are run with EXTMODE high: VCOM is inverted by TIM1_CH3N on
+ * EXTCOMIN (PB1, 1 Hz), so M1 is ignored and neither the bus nor the CPU
+ * has to wake up for it. PB1 is free with every transport, including the
+ * parallel bus that takes PA6.
+ */
+
+#define MEMLCD_CMD_WRITE 0x80U  // M0, sent MSB first
+#define MEMLCD_DUMMY 0x00U
+
+typedef struct
+{
+  u8g2_t *u8g2;
+  u8g2_draw_ll_hvline_cb hvline;
+  uint8_t dirty[U8X8_MEMLCD_LINES / 8U];  // to be sent
+  uint8_t drawn[U8X8_MEMLCD_LINES / 8U];  // not blank since the last clear
+} memlcd_t;
+
+static memlcd_t memlcd[U8X8_MEMLCD_SLOTS];
+
+static memlcd_t *memlcd_find(const u8g2_t *u8g2)
+{
+  for (uint8_t i = 0U; i < U8X8_MEMLCD_SLOTS; i++)
+  {
+    if (memlcd[i].u8g2 == u8g2)
+      return &memlcd[i];
+  }
+  return NULL;
+}
+
+static void memlcd_hvline(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir)
+{
+  memlcd_t *m = memlcd_find(u8g2);
+  u8g2_uint_t last = (dir == 0U) ? y : (u8g2_uint_t)(y + len - 1U);
+  if (last >= U8X8_MEMLCD_LINES)
+    last = U8X8_MEMLCD_LINES - 1U;
+  for (u8g2_uint_t line = y; line <= last; line++)
+  {
+    m->dirty[line >> 3] |= (uint8_t)(1U << (line & 7U));
+    m->drawn[line >> 3] |= (uint8_t)(1U << (line & 7U));
+  }
+  m->hvline(u8g2, x, y, len, dir);
+}
+
+void u8g2_memlcd_attach(u8g2_t *u8g2)
+{
+  memlcd_t *m = memlcd_find(u8g2);
+  if (m == NULL)
+  {
+    m = memlcd_find(NULL);
+    if (m == NULL)
+      return;  // out of slots, sendBuffer falls back to nothing marked
+    m->u8g2 = u8g2;
+    m->hvline = u8g2->ll_hvline;
+    u8g2->ll_hvline = memlcd_hvline;
+  }
+  u8g2_memlcd_mark_all(u8g2);
+}
+
+void u8g2_memlcd_mark_all(u8g2_t *u8g2)
+{
+  memlcd_t *m = memlcd_find(u8g2);
+  if (m == NULL)
+    return;
+  memset(m->dirty, 0xFF, sizeof(m->dirty));
+  memset(m->drawn, 0xFF, sizeof(m->drawn));
+}
+
+void u8g2_memlcd_clear(u8g2_t *u8g2)
+{
+  memlcd_t *m = memlcd_find(u8g2);
+  u8g2_ClearBuffer(u8g2);
+  if (m == NULL)
+    return;
+  for (uint8_t i = 0U; i < sizeof(m->dirty); i++)
+  {
+    m->dirty[i] |= m->drawn[i];
+    m->drawn[i] = 0U;
+  }
+}
+
+void u8g2_memlcd_send(u8g2_t *u8g2)
+{
+  memlcd_t *m = memlcd_find(u8g2);
+  u8x8_t *u8x8 = u8g2_GetU8x8(u8g2);
+  const uint8_t stride = u8x8->display_info->tile_width;
+  uint16_t lines = u8x8->display_info->pixel_height;
+  uint8_t started = 0U;
+
+  if (m == NULL)
+    return;
+  if (lines > U8X8_MEMLCD_LINES)
+    lines = U8X8_MEMLCD_LINES;
+  for (uint16_t line = 0U; line < lines; line++)
+  {
+    const uint8_t bit = (uint8_t)(1U << (line & 7U));
+    if ((m->dirty[line >> 3] & bit) == 0U)
+      continue;
+    m->dirty[line >> 3] &= (uint8_t)~bit;
+    if (!started)
+    {
+      u8x8_byte_StartTransfer(u8x8);
+      u8x8_byte_SendByte(u8x8, MEMLCD_CMD_WRITE);
+      started = 1U;
+    }
+    // line numbers start at 1 and go out LSB first
+    u8x8_byte_SendByte(u8x8, (uint8_t)(__RBIT(line + 1U) >> 24));
+    u8x8_byte_SendBytes(u8x8, stride, u8g2->tile_buf_ptr + line * stride);
+    u8x8_byte_SendByte(u8x8, MEMLCD_DUMMY);
+  }
+  if (started)
+  {
+    u8x8_byte_SendByte(u8x8, MEMLCD_DUMMY);
+    u8x8_byte_EndTransfer(u8x8);
+  }
+}
+
+void u8g2_memlcd_vcom_start(void)
+{
+  HAL_TIMEx_PWMN_Start(&htim1, TIM_CHANNEL_3);
+}
@@ -0,0 +1,148 @@
+/*
+ * u8g2_parallel.hpp
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: Władysław Ostrowski
+ */
+
+/*
+ This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef U8G2_PARALLEL_HPP
+#define U8G2_PARALLEL_HPP
+
+#include "u8g2_io.h"
+#include <array>
+#include <cstdint>
+
+namespace u8g2lib {
+
+/*
+ * 8-bit parallel bus for IoPolicy (see u8g2_policy.hpp). D0..D7 and the
+ * strobe (WR for 8080, E for 6800) sit on one port, in any pin order. The
+ * BSRR word that sets and resets the data pins for every byte value is
+ * computed at compile time, so a byte costs three stores: the data, the
+ * strobe driven active, and the strobe released, which is the edge the
+ * controller latches on (WR rising, E falling).
+ *
+ * start() turns the panel's data_setup_time_ns and write_pulse_width_ns
+ * into core cycles at the current SystemCoreClock. If either is longer
+ * than a store takes, the data is held for the setup time before the
+ * strobe goes active, and the strobe stays active and then inactive for
+ * the pulse width, as slow controllers such as the KS0108 need; otherwise
+ * the bytes go out back to back.
+ */
+template<uintptr_t PORT, uint16_t STROBE, bool STROBE_ACTIVE_HIGH, uint16_t... D>
+struct ParallelBus
+{
+    static_assert(sizeof...(D) == 8U, "ParallelBus needs exactly eight data pins");
+
+    static void init(u8x8_t *)
+    {
+        GPIO_InitTypeDef init = {0};
+        u8x8_gpio_release_uart(port(), DATA_MASK | STROBE);
+        init.Pin = DATA_MASK | STROBE;
+        init.Mode = GPIO_MODE_OUTPUT_PP;
+        init.Pull = GPIO_NOPULL;
+        init.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+        HAL_GPIO_Init(port(), &init);
+        port()->BSRR = RELEASE;
+        u8x8_delay_init();
+    }
+
+    static void start(u8x8_t *u8x8)
+    {
+        const auto *info = u8x8->display_info;
+        setup = waitCycles(info->data_setup_time_ns);
+        pulse = waitCycles(info->write_pulse_width_ns);
+    }
+
+    static inline __attribute__((always_inline)) void send(u8x8_t *, const uint8_t *data, uint8_t len)
+    {
+        if(setup == 0U && pulse == 0U)
+        {
+            while(len-- > 0U)
+            {
+                port()->BSRR = TABLE[*data++];
+                port()->BSRR = ASSERT;
+                port()->BSRR = RELEASE;
+            }
+        }
+        else
+        {
+            while(len-- > 0U)
+            {
+                port()->BSRR = TABLE[*data++];
+                u8x8_delay_cycles(setup);
+                port()->BSRR = ASSERT;
+                u8x8_delay_cycles(pulse);
+                port()->BSRR = RELEASE;
+                u8x8_delay_cycles(pulse);
+            }
+        }
+    }
+
+    static void flush() {}
+
+private:
+    // a BSRR store, shorter times need no wait
+    static constexpr uint32_t STORE_CYCLES = 2U;
+
+    static constexpr uint16_t DATA_PINS[8] = { D... };
+    static constexpr uint32_t DATA_MASK = (uint32_t{D} | ...);
+    static constexpr uint32_t ASSERT = STROBE_ACTIVE_HIGH ? STROBE : (uint32_t{STROBE} << 16);
+    static constexpr uint32_t RELEASE = STROBE_ACTIVE_HIGH ? (uint32_t{STROBE} << 16) : STROBE;
+
+    static inline uint32_t setup;
+    static inline uint32_t pulse;
+
+    static constexpr std::array<uint32_t, 256> makeTable()
+    {
+        std::array<uint32_t, 256> table{};
+        for(uint32_t b = 0U; b < 256U; b++)
+        {
+            uint32_t bsrr = 0U;
+            for(uint32_t bit = 0U; bit < 8U; bit++)
+            {
+                bsrr |= (b & (1U << bit)) ? DATA_PINS[bit] : (uint32_t{DATA_PINS[bit]} << 16);
+            }
+            table[b] = bsrr;
+        }
+        return table;
+    }
+
+    static constexpr std::array<uint32_t, 256> TABLE = makeTable();
+
+    static GPIO_TypeDef* port() { return reinterpret_cast<GPIO_TypeDef*>(PORT); }
+
+    static uint32_t waitCycles(const uint32_t ns)
+    {
+        const uint32_t cycles = (ns * (SystemCoreClock / 1000000U) + 999U) / 1000U;
+        return (cycles > STORE_CYCLES) ? cycles : 0U;
+    }
+};
+
+// 8080: data latched on the rising edge of an active-low WR
+template<uintptr_t PORT, uint16_t WR, uint16_t... D>
+using I8080Bus = ParallelBus<PORT, WR, false, D...>;
+
+// 6800: data latched on the falling edge of an active-high E, R/W tied low
+template<uintptr_t PORT, uint16_t E, uint16_t... D>
+using M6800Bus = ParallelBus<PORT, E, true, D...>;
+
+}
+
+#endif
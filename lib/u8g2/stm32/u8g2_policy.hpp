@@ -0,0 +1,169 @@
+/*
+ * u8g2_policy.hpp
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: Władysław Ostrowski
+ */
+
+/*
+ This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef U8G2_POLICY_HPP
+#define U8G2_POLICY_HPP
+
+#include "u8g2_io.h"
+#include "u8g2_sw_spi.hpp"
+#include "u8g2_sw_i2c.hpp"
+#include "u8g2_parallel.hpp"
+#include <cstdint>
+
+namespace u8g2lib {
+
+/*
+ * Control lines of one display, written straight to BSRR. Pins set with
+ * u8x8_SetPin (U8G2::setBusPins) take over from the compile-time ones, so
+ * displays sharing a bus keep their own CS/DC as with u8x8_gpio_and_delay.
+ */
+template<uintptr_t PORT, uint16_t CS, uint16_t DC, uint16_t RST>
+struct GpioPins
+{
+    static void init(u8x8_t *u8x8)
+    {
+        u8x8_gpio_init_pin(u8x8->pins[U8X8_PIN_CS]);
+        u8x8_gpio_init_pin(u8x8->pins[U8X8_PIN_DC]);
+        u8x8_gpio_init_pin(u8x8->pins[U8X8_PIN_RESET]);
+    }
+    static void cs(u8x8_t *u8x8, const uint8_t level) { write(u8x8->pins[U8X8_PIN_CS], CS, level); }
+    static void dc(u8x8_t *u8x8, const uint8_t level) { write(u8x8->pins[U8X8_PIN_DC], DC, level); }
+    static void reset(u8x8_t *u8x8, const uint8_t level) { write(u8x8->pins[U8X8_PIN_RESET], RST, level); }
+
+private:
+    static void write(const uint8_t pin, const uint16_t board_pin, const uint8_t level)
+    {
+        auto *port = reinterpret_cast<GPIO_TypeDef*>(PORT);
+        uint32_t mask = board_pin;
+        if(pin != U8X8_PIN_NONE)
+        {
+            port = U8X8_GPIO_PORT(pin);
+            mask = U8X8_GPIO_MASK(pin);
+        }
+        port->BSRR = level ? mask : (mask << 16);
+    }
+};
+
+/*
+ * Blocking SPI1, coalesced per DC run by u8x8_hw_spi_send().
+ */
+struct HalSpiBus
+{
+    static void init(u8x8_t *) { u8x8_hw_spi_init(); }
+    static void start(u8x8_t *u8x8) { u8x8_hw_spi_clock(u8x8); }
+    static void send(u8x8_t *, const uint8_t *data, uint8_t len) { u8x8_hw_spi_send(data, len); }
+    static void flush() { u8x8_hw_spi_flush(); }
+};
+
+/*
+ * Byte and GPIO/delay callbacks generated from a BUS and a PINS policy.
+ * u8g2 still calls them through u8x8->byte_cb, but everything below that
+ * (DC, CS, delays, the bus itself) is resolved at compile time and inlined
+ * instead of bouncing through gpio_and_delay_cb. Messages a 4-wire serial
+ * display never sends (D2..D7, E, menu buttons) have no handler at all.
+ */
+template<class BUS, class PINS>
+struct IoPolicy
+{
+    static uint8_t byte_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+    {
+        const auto *info = u8x8->display_info;
+        u8x8_stats_byte_msg(msg, arg_int);
+        switch(msg)
+        {
+            case U8X8_MSG_BYTE_SEND:
+                BUS::send(u8x8, static_cast<const uint8_t*>(arg_ptr), arg_int);
+                break;
+            case U8X8_MSG_BYTE_INIT:
+                BUS::init(u8x8);
+                PINS::cs(u8x8, info->chip_disable_level);
+                break;
+            case U8X8_MSG_BYTE_SET_DC:
+                // u8x8_cad_001 sets DC before every command byte, only a change ends the run
+                if(arg_int != dc_level)
+                {
+                    BUS::flush();
+                    PINS::dc(u8x8, arg_int);
+                    dc_level = arg_int;
+                }
+                break;
+            case U8X8_MSG_BYTE_START_TRANSFER:
+                dc_level = 0xFFU;
+                BUS::start(u8x8);
+                PINS::cs(u8x8, info->chip_enable_level);
+                u8x8_delay_ns(info->post_chip_enable_wait_ns);
+                break;
+            case U8X8_MSG_BYTE_END_TRANSFER:
+                BUS::flush();
+                u8x8_delay_ns(info->pre_chip_disable_wait_ns);
+                PINS::cs(u8x8, info->chip_disable_level);
+                break;
+            default:
+                return 0U;
+        }
+        return 1U;
+    }
+
+    static uint8_t gpio_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *)
+    {
+        switch(msg)
+        {
+            case U8X8_MSG_GPIO_AND_DELAY_INIT: u8x8_delay_init(); PINS::init(u8x8); break;
+            case U8X8_MSG_DELAY_NANO: u8x8_delay_ns(arg_int); break;
+            case U8X8_MSG_DELAY_100NANO: u8x8_delay_ns(arg_int * 100U); break;
+            case U8X8_MSG_DELAY_10MICRO: u8x8_delay_us(arg_int * 10U); break;
+            case U8X8_MSG_DELAY_MILLI: u8x8_delay_ms(arg_int); break;
+            case U8X8_MSG_GPIO_CS: PINS::cs(u8x8, arg_int); break;
+            case U8X8_MSG_GPIO_DC: PINS::dc(u8x8, arg_int); break;
+            case U8X8_MSG_GPIO_RESET: PINS::reset(u8x8, arg_int); break;
+            default: u8x8_SetGPIOResult(u8x8, 1U); break;
+        }
+        return 1U;
+    }
+
+private:
+    static inline uint8_t dc_level = 0xFFU;  // unknown until the first SET_DC of a transfer
+};
+
+/*
+ * Callbacks of a transport that is implemented in C (u8g2_io.c).
+ */
+template<u8x8_msg_cb BYTE_CB, u8x8_msg_cb GPIO_CB = u8x8_gpio_and_delay>
+struct CIo
+{
+    static constexpr u8x8_msg_cb byte_cb = BYTE_CB;
+    static constexpr u8x8_msg_cb gpio_cb = GPIO_CB;
+};
+
+// NUCLEO-L432KC wiring, pins as in u8g2_io.h
+using BoardPins = GpioPins<GPIOA_BASE, CS_Pin, DC_Pin, RST_Pin>;
+using BoardSwSpiBus = SwSpiBus<GPIOA_BASE, CLK_Pin, MOSI_Pin>;
+using BoardSwI2cBus = SwI2cBus<GPIOB_BASE, SWI2C_SCL_Pin, SWI2C_SDA_Pin>;
+using BoardI2cPins = GpioPins<GPIOA_BASE, 0U, 0U, RST_Pin>;  // no CS/DC on I2C
+using BoardI8080Bus = I8080Bus<GPIOA_BASE, PAR_WR_Pin, PAR_D0_Pin, PAR_D1_Pin, PAR_D2_Pin,
+    PAR_D3_Pin, PAR_D4_Pin, PAR_D5_Pin, PAR_D6_Pin, PAR_D7_Pin>;
+using BoardM6800Bus = M6800Bus<GPIOA_BASE, PAR_WR_Pin, PAR_D0_Pin, PAR_D1_Pin, PAR_D2_Pin,
+    PAR_D3_Pin, PAR_D4_Pin, PAR_D5_Pin, PAR_D6_Pin, PAR_D7_Pin>;
+
+}
+
+#endif
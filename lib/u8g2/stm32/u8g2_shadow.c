@@ -0,0 +1,262 @@
+/*
+ * u8g2_shadow.c
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: Władysław Ostrowski
+ */
+
+/*
+ This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "u8g2_io.h"
+
+/*
+ * Controller state shadow for SH1106/SSD1306 style command sets.
+ *
+ * u8x8_shadow_attach() puts u8x8_byte_shadow in front of the display's
+ * byte callback. Command runs (bytes sent with DC low) that consist only
+ * of page (0xB0..0xB7) and column (0x00..0x1F) addressing are held back;
+ * when the run ends, only the commands that change the tracked page or
+ * column go out. Data bytes advance the tracked column; past the last
+ * column of controller RAM (128 on SSD1306, 132 on SH1106) the pointer
+ * wraps to column 0. In page addressing mode (SH1106) it stays on its
+ * page; in horizontal addressing mode, which the SSD1306 init sequence
+ * selects with 0x20 0x00, it moves on to the next page, after page 7 to
+ * page 0. Any other command run or a reset makes the shadow forget
+ * everything.
+ */
+
+#define SHADOW_PAGE 0x01U
+#define SHADOW_COL  0x02U
+#define SHADOW_HELD 6U
+
+typedef struct
+{
+  u8x8_t *u8x8;
+  u8x8_msg_cb next;
+  uint8_t valid;
+  uint8_t page;
+  uint8_t col;
+  uint8_t columns;   // controller RAM width
+  uint8_t horizontal; // column wrap moves on to the next page
+  uint8_t dc;        // level u8x8 asked for
+  uint8_t out_dc;    // level the transport has, 0xFF unknown
+  uint8_t pure;      // current command run is addressing only
+  uint8_t held_len;
+  uint8_t held[SHADOW_HELD];
+} shadow_t;
+
+static shadow_t shadow[U8X8_SHADOW_SLOTS];
+
+static shadow_t *shadow_find(const u8x8_t *u8x8)
+{
+  for (uint8_t i = 0U; i < U8X8_SHADOW_SLOTS; i++)
+  {
+    if (shadow[i].u8x8 == u8x8)
+      return &shadow[i];
+  }
+  return NULL;
+}
+
+void u8x8_shadow_attach(u8x8_t *u8x8, uint8_t columns, uint8_t horizontal)
+{
+  if (u8x8->byte_cb == u8x8_byte_shadow)
+    return;
+  shadow_t *sh = shadow_find(u8x8);  // set up again, the old slot is stale
+  if (sh == NULL)
+    sh = shadow_find(NULL);
+  if (sh == NULL)
+    return;  // out of slots, the display just runs unfiltered
+  sh->u8x8 = u8x8;
+  sh->next = u8x8->byte_cb;
+  sh->columns = columns;
+  sh->horizontal = horizontal;
+  sh->valid = 0U;
+  u8x8->byte_cb = u8x8_byte_shadow;
+}
+
+static void shadow_send(shadow_t *sh, uint8_t dc, const uint8_t *data, uint8_t len)
+{
+  if (len == 0U)
+    return;
+  if (sh->out_dc != dc)
+  {
+    sh->next(sh->u8x8, U8X8_MSG_BYTE_SET_DC, dc, NULL);
+    sh->out_dc = dc;
+  }
+  sh->next(sh->u8x8, U8X8_MSG_BYTE_SEND, len, (void *)data);
+}
+
+static uint8_t shadow_is_addressing(uint8_t cmd)
+{
+  return cmd <= 0x1FU || (cmd >= 0xB0U && cmd <= 0xB7U);
+}
+
+// end of a command run: send what the held addressing commands change
+static void shadow_resolve(shadow_t *sh)
+{
+  uint8_t page = sh->page;
+  uint8_t col = sh->col;
+  uint8_t set_page = 0U, set_hi = 0U, set_lo = 0U;
+
+  if (!sh->pure || sh->held_len == 0U)
+    return;
+  for (uint8_t i = 0U; i < sh->held_len; i++)
+  {
+    const uint8_t cmd = sh->held[i];
+    if (cmd >= 0xB0U)
+    {
+      page = cmd & 0x07U;
+      set_page = 1U;
+    }
+    else if (cmd >= 0x10U)
+    {
+      col = (uint8_t)((col & 0x0FU) | ((cmd & 0x0FU) << 4));
+      set_hi = 1U;
+    }
+    else
+    {
+      col = (uint8_t)((col & 0xF0U) | cmd);
+      set_lo = 1U;
+    }
+  }
+
+  if (set_hi != set_lo && !(sh->valid & SHADOW_COL))
+  {
+    // half a column address on top of an unknown one, pass it on as is
+    shadow_send(sh, 0U, sh->held, sh->held_len);
+    sh->held_len = 0U;
+    if (set_page)
+    {
+      sh->page = page;
+      sh->valid |= SHADOW_PAGE;
+    }
+    return;
+  }
+
+  uint8_t out[3];
+  uint8_t n = 0U;
+  if (set_page && (!(sh->valid & SHADOW_PAGE) || sh->page != page))
+    out[n++] = (uint8_t)(0xB0U | page);
+  if ((set_hi || set_lo) && (!(sh->valid & SHADOW_COL) || sh->col != col))
+  {
+    out[n++] = (uint8_t)(0x10U | (col >> 4));
+    out[n++] = (uint8_t)(col & 0x0FU);
+  }
+  if (n < sh->held_len)
+    u8x8_stats.elided += sh->held_len - n;
+  shadow_send(sh, 0U, out, n);
+  if (set_page)
+    sh->valid |= SHADOW_PAGE;
+  if (set_hi || set_lo)
+    sh->valid |= SHADOW_COL;
+  sh->page = page;
+  sh->col = col;
+  sh->held_len = 0U;
+}
+
+// data moved the RAM pointer by len columns
+static void shadow_advance(shadow_t *sh, uint8_t len)
+{
+  const uint16_t end = (uint16_t)sh->col + len;
+  if (!sh->horizontal)
+  {
+    sh->col = (uint8_t)(end % sh->columns);
+    return;
+  }
+  if (!(sh->valid & SHADOW_COL))
+  {
+    sh->valid &= (uint8_t)~SHADOW_PAGE;  // can't tell whether it wrapped
+    return;
+  }
+  sh->col = (uint8_t)(end % sh->columns);
+  sh->page = (uint8_t)((sh->page + end / sh->columns) & 0x07U);
+}
+
+// a command the shadow does not understand: flush and forget
+static void shadow_spill(shadow_t *sh)
+{
+  shadow_send(sh, 0U, sh->held, sh->held_len);
+  sh->held_len = 0U;
+  sh->pure = 0U;
+  sh->valid = 0U;
+}
+
+uint8_t u8x8_byte_shadow(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  shadow_t *sh = shadow_find(u8x8);
+  const uint8_t *data = (const uint8_t *)arg_ptr;
+
+  switch(msg) {
+    case U8X8_MSG_BYTE_SEND:
+      if (sh->dc != 0U)
+      {
+        shadow_send(sh, sh->dc, data, arg_int);
+        shadow_advance(sh, arg_int);
+        return 1;
+      }
+      while (arg_int > 0U && sh->pure)
+      {
+        if (!shadow_is_addressing(*data) || sh->held_len == SHADOW_HELD)
+        {
+          shadow_spill(sh);
+          break;
+        }
+        sh->held[sh->held_len++] = *data++;
+        arg_int--;
+      }
+      shadow_send(sh, 0U, data, arg_int);
+      return 1;
+
+    case U8X8_MSG_BYTE_SET_DC:
+      if (arg_int != sh->dc)
+      {
+        if (sh->dc == 0U)
+          shadow_resolve(sh);
+        sh->dc = arg_int;
+        sh->pure = 1U;
+        sh->held_len = 0U;
+      }
+      return 1;
+
+    case U8X8_MSG_BYTE_START_TRANSFER:
+      sh->dc = 0U;
+      sh->out_dc = 0xFFU;
+      sh->pure = 1U;
+      sh->held_len = 0U;
+      break;
+
+    case U8X8_MSG_BYTE_END_TRANSFER:
+      if (sh->dc == 0U)
+        shadow_resolve(sh);
+      break;
+
+    case U8X8_MSG_BYTE_INIT:
+      sh->valid = 0U;
+      break;
+
+    default:
+      break;
+  }
+  return sh->next(u8x8, msg, arg_int, arg_ptr);
+}
+
+void u8x8_shadow_invalidate(u8x8_t *u8x8)
+{
+  shadow_t *sh = shadow_find(u8x8);
+  if (sh != NULL)
+    sh->valid = 0U;
+}
@@ -0,0 +1,150 @@
+/*
+ * u8g2_spi_3w.c
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: Władysław Ostrowski
+ */
+
+/*
+ This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "u8g2_io.h"
+
+extern SPI_HandleTypeDef hspi1;
+extern DMA_HandleTypeDef hdma_spi1_tx;
+
+/*
+ * 3-wire transport: SPI1 runs with 9-bit frames and the DC level rides in
+ * bit 8 of every frame, so SET_DC costs nothing and never splits a burst.
+ * Frames are built in one of two halfword buffers while DMA streams the
+ * other one; CS is released from the TX complete interrupt.
+ * SPI1 and its TX DMA channel are switched to 9-bit/halfword at BYTE_INIT,
+ * the 8-bit transports can not be used next to this one.
+ */
+static uint16_t w3_buf[2][U8X8_3W_BUF_FRAMES];
+static uint16_t w3_fill_len = 0U;
+static uint8_t w3_fill = 0U;
+static uint16_t w3_dc = 0U;
+static volatile uint8_t w3_busy = 0U;
+static volatile uint8_t w3_cs_release = 0U;
+static u8x8_t *w3_u8x8 = NULL;
+
+static void w3_setup(void)
+{
+  hspi1.Init.DataSize = SPI_DATASIZE_9BIT;
+  if (HAL_SPI_Init(&hspi1) != HAL_OK)
+    u8x8_stats.errors++;
+  hdma_spi1_tx.Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+  hdma_spi1_tx.Init.MemDataAlignment = DMA_MDATAALIGN_HALFWORD;
+  if (HAL_DMA_Init(&hdma_spi1_tx) != HAL_OK)
+    u8x8_stats.errors++;
+}
+
+static void w3_kick(void)
+{
+  if (w3_fill_len == 0U)
+    return;
+  u8x8_hw_spi_3w_wait();
+  w3_busy = 1U;
+  if (HAL_SPI_Transmit_DMA(&hspi1, (uint8_t *)w3_buf[w3_fill], w3_fill_len) != HAL_OK)
+  {
+    w3_busy = 0U;
+    u8x8_stats.errors++;  // the frames are dropped
+  }
+  w3_fill ^= 1U;
+  w3_fill_len = 0U;
+}
+
+uint8_t u8x8_hw_spi_3w_is_busy(void)
+{
+  return w3_busy;
+}
+
+void u8x8_hw_spi_3w_wait(void)
+{
+  while (w3_busy)
+    ;
+}
+
+uint8_t u8x8_hw_spi_3w_done(SPI_HandleTypeDef *hspi)
+{
+  if (hspi != &hspi1 || !w3_busy)
+    return 0U;
+  w3_busy = 0U;
+  if (w3_cs_release)
+  {
+    w3_cs_release = 0U;
+    w3_u8x8->gpio_and_delay_cb(w3_u8x8, U8X8_MSG_DELAY_NANO, w3_u8x8->display_info->pre_chip_disable_wait_ns, NULL);
+    u8x8_gpio_SetCS(w3_u8x8, w3_u8x8->display_info->chip_disable_level);
+  }
+  return 1U;
+}
+
+uint8_t u8x8_byte_hw_spi_3w(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  u8x8_stats_byte_msg(msg, arg_int);
+  switch(msg) {
+    case U8X8_MSG_BYTE_SEND:
+    {
+      const uint8_t* data = (const uint8_t *)arg_ptr;
+      while (arg_int-- > 0U)
+      {
+        w3_buf[w3_fill][w3_fill_len++] = w3_dc | *data++;
+        if (w3_fill_len == U8X8_3W_BUF_FRAMES)
+          w3_kick();
+      }
+    }
+      break;
+
+    case U8X8_MSG_BYTE_INIT:
+      u8x8_hw_spi_3w_wait();
+      w3_setup();
+      u8x8_gpio_SetCS(u8x8, u8x8->display_info->chip_disable_level);
+      break;
+
+    case U8X8_MSG_BYTE_SET_DC:
+      w3_dc = arg_int ? 0x100U : 0U;
+      break;
+
+    case U8X8_MSG_BYTE_START_TRANSFER:
+      u8x8_hw_spi_3w_wait();
+      w3_u8x8 = u8x8;
+      u8x8_hw_spi_clock(u8x8);
+      u8x8_gpio_SetCS(u8x8, u8x8->display_info->chip_enable_level);
+      u8x8->gpio_and_delay_cb(u8x8, U8X8_MSG_DELAY_NANO, u8x8->display_info->post_chip_enable_wait_ns, NULL);
+      break;
+
+    case U8X8_MSG_BYTE_END_TRANSFER:
+      w3_kick();
+      __disable_irq();
+      if (w3_busy)
+      {
+        w3_cs_release = 1U;
+        __enable_irq();
+      }
+      else
+      {
+        __enable_irq();
+        u8x8->gpio_and_delay_cb(u8x8, U8X8_MSG_DELAY_NANO, u8x8->display_info->pre_chip_disable_wait_ns, NULL);
+        u8x8_gpio_SetCS(u8x8, u8x8->display_info->chip_disable_level);
+      }
+      break;
+
+    default:
+      return 0;
+  }
+  return 1;
+}
@@ -0,0 +1,506 @@
+/*
+ * u8g2_spi_dma.c
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: Władysław Ostrowski
+ */
+
+/*
+ This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "u8g2_io.h"
+#include <string.h>
+
+extern SPI_HandleTypeDef hspi1;
+
+/*
+ * DMA transport and SPI1 bus arbiter.
+ *
+ * The byte callback never touches the bus. It cuts every u8x8 transfer
+ * into segments (one DC level, at most one slot of data) and queues them.
+ * The queue is drained by DMA1_Channel3: HAL_SPI_TxCpltCallback finishes a
+ * segment, drives CS/DC of the next segment's display and restarts DMA.
+ * Any number of displays with their own CS/DC (see U8X8_GPIO_PIN) can
+ * share the bus; their transfers go out back-to-back in queue order.
+ *
+ * Data is copied into the segment slot because u8x8 passes pointers to
+ * stack variables for command bytes. Lent regions (u8x8_hw_spi_dma_lend)
+ * are referenced instead.
+ *
+ * Between u8x8_hw_spi_dma_frame_begin() and _frame_end() nothing is queued;
+ * the whole command+data stream is recorded into frame_buf together with
+ * a table of runs (offset, length, DC, CS edges). The frame then occupies
+ * a single queue entry and the interrupt walks its runs, switching DC at
+ * the precomputed offsets, so a full sendBuffer() needs no CPU time after
+ * it returns. Lent payloads are copied as well while they fit; the rest is
+ * referenced in place and _frame_end() then waits until the frame is out,
+ * so the lender has its buffer back on return either way. Payloads that
+ * are not lent must fit in U8X8_FRAME_BUF_SIZE, and a recording holds at
+ * most U8X8_FRAME_RUNS runs; past either limit the part recorded so far is
+ * sent and waited for before recording goes on.
+ *
+ * Between u8x8_hw_spi_dma_fill_begin() and _fill_end() the content of data
+ * bytes (DC high) is ignored: they become fill runs that hold one pattern
+ * byte and a count, sent with DMA memory increment off. A display clear
+ * then needs neither a zeroed buffer nor a copy, only the page commands.
+ */
+
+#define SEG_FIRST 0x01U  // assert CS before the run
+#define SEG_LAST  0x02U  // release CS after the run
+#define SEG_FRAME 0x04U  // queue entry stands for the recorded frame
+#define SEG_FILL  0x08U  // data is one pattern byte, sent len times
+
+typedef struct
+{
+  u8x8_t *u8x8;
+  const uint8_t *data;
+  uint16_t len;
+  uint8_t dc;
+  uint8_t flags;
+} bus_run_t;
+
+typedef struct
+{
+  bus_run_t run;
+  uint8_t buf[U8X8_BUS_SLOT_SIZE];
+} bus_seg_t;
+
+static bus_seg_t bus_seg[U8X8_BUS_SLOTS];
+static volatile uint8_t seg_head = 0U;     // next slot to publish, main only
+static volatile uint8_t seg_tail = 0U;     // oldest unfinished slot, ISR only
+static volatile uint8_t bus_running = 0U;
+static volatile uint32_t seg_queued = 0U;
+static volatile uint32_t seg_done = 0U;
+
+// segment under construction in bus_seg[seg_head]
+static uint8_t open = 0U;
+static uint8_t first = 0U;
+static uint8_t dc = 0U;
+static u8x8_t *owner = NULL;
+
+static const uint8_t *lent = NULL;
+static uint16_t lent_len = 0U;
+
+static uint8_t fill = 0U;
+static uint8_t fill_pattern = 0U;
+
+// recorded frame, frame_pos is the run on the wire
+static uint8_t frame_buf[U8X8_FRAME_BUF_SIZE];
+static bus_run_t frame_run[U8X8_FRAME_RUNS];
+static uint16_t frame_len = 0U;
+static uint8_t frame_runs = 0U;
+static volatile uint8_t frame_pos = 0U;
+static uint8_t recording = 0U;
+static uint8_t rec_open = 0U;
+static uint8_t frame_lent = 0U;  // a run references the lent region
+static uint32_t frame_ticket = 0U;
+
+#define SEG_NEXT(i) ((uint8_t)(((i) + 1U) % U8X8_BUS_SLOTS))
+
+static bus_run_t *bus_run(void)
+{
+  bus_seg_t *seg = &bus_seg[seg_tail];
+  return (seg->run.flags & SEG_FRAME) ? &frame_run[frame_pos] : &seg->run;
+}
+
+static void bus_run_done(void)
+{
+  if (bus_seg[seg_tail].run.flags & SEG_FRAME)
+  {
+    if (++frame_pos < frame_runs)
+      return;
+    frame_pos = 0U;
+  }
+  seg_tail = SEG_NEXT(seg_tail);
+  seg_done++;
+}
+
+// CCR may only be written while the channel is off, HAL_DMA_Start_IT turns it on
+static void bus_minc(uint8_t on)
+{
+  DMA_Channel_TypeDef *ch = hspi1.hdmatx->Instance;
+  if (((ch->CCR & DMA_CCR_MINC) != 0U) == (on != 0U))
+    return;
+  ch->CCR &= ~DMA_CCR_EN;
+  if (on)
+    ch->CCR |= DMA_CCR_MINC;
+  else
+    ch->CCR &= ~DMA_CCR_MINC;
+}
+
+// runs with interrupts disabled or from the DMA/SPI interrupt
+static void bus_next(void)
+{
+  while (seg_tail != seg_head)
+  {
+    bus_run_t *run = bus_run();
+    u8x8_t *u8x8 = run->u8x8;
+    if (run->flags & SEG_FIRST)
+    {
+      u8x8_hw_spi_clock(u8x8);
+      u8x8_gpio_SetCS(u8x8, u8x8->display_info->chip_enable_level);
+      u8x8->gpio_and_delay_cb(u8x8, U8X8_MSG_DELAY_NANO, u8x8->display_info->post_chip_enable_wait_ns, NULL);
+    }
+    u8x8_gpio_SetDC(u8x8, run->dc);
+    if (run->len > 0U)
+    {
+      bus_running = 1U;
+      bus_minc((run->flags & SEG_FILL) == 0U);
+      if (HAL_SPI_Transmit_DMA(&hspi1, (uint8_t *)run->data, run->len) == HAL_OK)
+        return;
+      u8x8_stats.errors++;  // the run is dropped, CS still goes back up
+    }
+    if (run->flags & SEG_LAST)
+    {
+      u8x8->gpio_and_delay_cb(u8x8, U8X8_MSG_DELAY_NANO, u8x8->display_info->pre_chip_disable_wait_ns, NULL);
+      u8x8_gpio_SetCS(u8x8, u8x8->display_info->chip_disable_level);
+    }
+    bus_run_done();
+  }
+  bus_running = 0U;
+}
+
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+  if (u8x8_hw_spi_3w_done(hspi))
+    return;
+  if (hspi != &hspi1 || !bus_running)
+    return;
+  bus_run_t *run = bus_run();
+  if (run->flags & SEG_LAST)
+  {
+    u8x8_t *u8x8 = run->u8x8;
+    u8x8->gpio_and_delay_cb(u8x8, U8X8_MSG_DELAY_NANO, u8x8->display_info->pre_chip_disable_wait_ns, NULL);
+    u8x8_gpio_SetCS(u8x8, u8x8->display_info->chip_disable_level);
+  }
+  bus_run_done();
+  bus_next();
+}
+
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi)
+{
+  if (hspi == &hspi1)
+    u8x8_stats.errors++;
+  HAL_SPI_TxCpltCallback(hspi);
+}
+
+static void seg_publish(void)
+{
+  __disable_irq();
+  seg_head = SEG_NEXT(seg_head);
+  seg_queued++;
+  if (!bus_running)
+    bus_next();
+  __enable_irq();
+}
+
+static bus_seg_t *seg_reserve(void)
+{
+  while (SEG_NEXT(seg_head) == seg_tail)
+    ;
+  return &bus_seg[seg_head];
+}
+
+static bus_run_t *seg_open(void)
+{
+  if (!open)
+  {
+    bus_seg_t *seg = seg_reserve();
+    seg->run.u8x8 = owner;
+    seg->run.data = seg->buf;
+    seg->run.len = 0U;
+    seg->run.dc = dc;
+    seg->run.flags = first ? SEG_FIRST : 0U;
+    first = 0U;
+    open = 1U;
+  }
+  return &bus_seg[seg_head].run;
+}
+
+static void seg_close(uint8_t flags)
+{
+  if (!open)
+    return;
+  bus_seg[seg_head].run.flags |= flags;
+  open = 0U;
+  seg_publish();
+}
+
+static void frame_queue(void)
+{
+  if (frame_runs == 0U)
+    return;
+  bus_seg_t *seg = seg_reserve();
+  seg->run.flags = SEG_FRAME;
+  seg->run.len = 0U;
+  seg_publish();
+  frame_ticket = seg_queued;
+}
+
+static void rec_restart(void)
+{
+  rec_open = 0U;
+  frame_queue();
+  u8x8_hw_spi_dma_wait_ticket(frame_ticket);
+  frame_len = 0U;
+  frame_runs = 0U;
+}
+
+static bus_run_t *rec_open_run(void)
+{
+  if (!rec_open || frame_runs == 0U)
+  {
+    if (frame_runs == U8X8_FRAME_RUNS)
+      rec_restart();  // table full, send what we have and start over
+    bus_run_t *run = &frame_run[frame_runs++];
+    run->u8x8 = owner;
+    run->data = &frame_buf[frame_len];
+    run->len = 0U;
+    run->dc = dc;
+    run->flags = first ? SEG_FIRST : 0U;
+    first = 0U;
+    rec_open = 1U;
+  }
+  return &frame_run[frame_runs - 1U];
+}
+
+// the open run if it ends at p, otherwise a new one starting there;
+// p NULL stands for the end of frame_buf, which a restart moves
+static bus_run_t *rec_run_at(const uint8_t *p)
+{
+  if (rec_open && frame_runs > 0U)
+  {
+    bus_run_t *run = &frame_run[frame_runs - 1U];
+    if (run->data + run->len == ((p != NULL) ? p : &frame_buf[frame_len]))
+      return run;
+    rec_open = 0U;
+  }
+  bus_run_t *run = rec_open_run();
+  if (p != NULL)
+    run->data = p;
+  return run;
+}
+
+static uint8_t rec_open_is_fill(void)
+{
+  return rec_open && frame_runs > 0U && (frame_run[frame_runs - 1U].flags & SEG_FILL);
+}
+
+static void rec_send(const uint8_t *data, uint16_t len)
+{
+  if (rec_open_is_fill())
+    rec_open = 0U;
+  if (lent != NULL && data >= lent && data + len <= lent + lent_len
+      && frame_len + len > U8X8_FRAME_BUF_SIZE)
+  {
+    rec_run_at(data)->len += len;
+    frame_lent = 1U;
+    return;
+  }
+  while (len > 0U)
+  {
+    if (frame_len == U8X8_FRAME_BUF_SIZE)
+      rec_restart();
+    bus_run_t *run = rec_run_at(NULL);
+    uint16_t n = U8X8_FRAME_BUF_SIZE - frame_len;
+    if (n > len)
+      n = len;
+    memcpy(&frame_buf[frame_len], data, n);
+    frame_len += n;
+    run->len += n;
+    data += n;
+    len -= n;
+  }
+}
+
+void u8x8_hw_spi_dma_frame_begin(void)
+{
+  // frame_buf is still on the wire until the previous frame completed
+  u8x8_hw_spi_dma_wait_ticket(frame_ticket);
+  frame_len = 0U;
+  frame_runs = 0U;
+  rec_open = 0U;
+  frame_lent = 0U;
+  recording = 1U;
+}
+
+uint32_t u8x8_hw_spi_dma_frame_end(void)
+{
+  recording = 0U;
+  rec_open = 0U;
+  frame_queue();
+  if (frame_lent)
+    u8x8_hw_spi_dma_wait_ticket(frame_ticket);
+  return seg_queued;
+}
+
+uint8_t u8x8_hw_spi_dma_is_busy(void)
+{
+  return bus_running || seg_tail != seg_head;
+}
+
+void u8x8_hw_spi_dma_wait(void)
+{
+  while (u8x8_hw_spi_dma_is_busy())
+    ;
+}
+
+uint32_t u8x8_hw_spi_dma_ticket(void)
+{
+  return seg_queued;
+}
+
+uint8_t u8x8_hw_spi_dma_done(uint32_t ticket)
+{
+  return (int32_t)(seg_done - ticket) >= 0;
+}
+
+void u8x8_hw_spi_dma_wait_ticket(uint32_t ticket)
+{
+  while (!u8x8_hw_spi_dma_done(ticket))
+    ;
+}
+
+/*
+ * Payloads that lie inside the lent region are sent straight from there
+ * without a copy. The caller must not touch the region until the ticket
+ * taken after queuing it has completed.
+ */
+void u8x8_hw_spi_dma_lend(const uint8_t *buf, uint16_t len)
+{
+  lent = buf;
+  lent_len = len;
+}
+
+static void fill_send(uint16_t len)
+{
+  bus_run_t *run;
+  if (recording)
+  {
+    if (!rec_open_is_fill())
+    {
+      rec_open = 0U;
+      if (frame_len == U8X8_FRAME_BUF_SIZE)
+        rec_restart();
+      run = rec_open_run();
+      run->flags |= SEG_FILL;
+      frame_buf[frame_len++] = fill_pattern;
+    }
+    frame_run[frame_runs - 1U].len += len;
+    return;
+  }
+  if (!open || (bus_seg[seg_head].run.flags & SEG_FILL) == 0U)
+  {
+    seg_close(0U);
+    run = seg_open();
+    run->flags |= SEG_FILL;
+    bus_seg[seg_head].buf[0] = fill_pattern;
+  }
+  bus_seg[seg_head].run.len += len;
+}
+
+static void dma_send(const uint8_t *data, uint16_t len)
+{
+  if (fill && dc)
+  {
+    fill_send(len);
+    return;
+  }
+  if (!recording && open && (bus_seg[seg_head].run.flags & SEG_FILL))
+    seg_close(0U);
+  if (recording)
+  {
+    rec_send(data, len);
+    return;
+  }
+  if (lent != NULL && data >= lent && data + len <= lent + lent_len)
+  {
+    seg_close(0U);
+    bus_run_t *run = seg_open();
+    run->data = data;
+    run->len = len;
+    seg_close(0U);
+    return;
+  }
+  while (len > 0U)
+  {
+    bus_run_t *run = seg_open();
+    uint16_t n = U8X8_BUS_SLOT_SIZE - run->len;
+    if (n > len)
+      n = len;
+    memcpy(&bus_seg[seg_head].buf[run->len], data, n);
+    run->len += n;
+    data += n;
+    len -= n;
+    if (run->len == U8X8_BUS_SLOT_SIZE)
+      seg_close(0U);
+  }
+}
+
+void u8x8_hw_spi_dma_fill_begin(uint8_t pattern)
+{
+  fill_pattern = pattern;
+  fill = 1U;
+}
+
+void u8x8_hw_spi_dma_fill_end(void)
+{
+  fill = 0U;
+}
+
+uint8_t u8x8_byte_hw_spi_dma(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  u8x8_stats_byte_msg(msg, arg_int);
+  switch(msg) {
+    case U8X8_MSG_BYTE_SEND:
+      dma_send((const uint8_t *)arg_ptr, arg_int);
+      break;
+
+    case U8X8_MSG_BYTE_INIT:
+      u8x8_hw_spi_dma_wait();
+      u8x8_gpio_SetCS(u8x8, u8x8->display_info->chip_disable_level);
+      break;
+
+    case U8X8_MSG_BYTE_SET_DC:
+      if (dc != arg_int)
+      {
+        seg_close(0U);
+        rec_open = 0U;
+      }
+      dc = arg_int;
+      break;
+
+    case U8X8_MSG_BYTE_START_TRANSFER:
+      owner = u8x8;
+      first = 1U;
+      rec_open = 0U;
+      break;
+
+    case U8X8_MSG_BYTE_END_TRANSFER:
+      if (recording)
+      {
+        rec_open_run()->flags |= SEG_LAST;
+        rec_open = 0U;
+        break;
+      }
+      seg_open();
+      seg_close(SEG_LAST);
+      break;
+
+    default:
+      return 0;
+  }
+  return 1;
+}
@@ -0,0 +1,156 @@
+/*
+ * u8g2_sw_i2c.hpp
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: Władysław Ostrowski
+ */
+
+/*
+ This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef U8G2_SW_I2C_HPP
+#define U8G2_SW_I2C_HPP
+
+#include "u8g2_io.h"
+#include <cstdint>
+
+namespace u8g2lib {
+
+/*
+ * Software I2C master for IoPolicy (see u8g2_policy.hpp). SCL and SDA are
+ * open-drain outputs on one port: a BSRR set releases the line to the
+ * pull-up, a reset drives it low, IDR tells what the bus really does.
+ * Every edge waits for the DWT cycle counter to reach half a bit time
+ * since the previous one, so loop overhead is absorbed instead of added
+ * and the bit rate follows SystemCoreClock.
+ *
+ * start() sends START and the address, send() the bytes, flush() STOP.
+ * A slave holding SCL low (clock stretching) is waited for, up to a
+ * millisecond before the transfer is given up as a timeout; no further
+ * bit is clocked then, flush() still tries STOP. A NACK counts as an error
+ * and drops the rest of the transfer.
+ */
+template<uintptr_t PORT, uint16_t SCL, uint16_t SDA, uint32_t KHZ = 400U>
+struct SwI2cBus
+{
+    static void init(u8x8_t *)
+    {
+        GPIO_InitTypeDef init = {0};
+        port()->BSRR = SCL | SDA;
+        init.Pin = SCL | SDA;
+        init.Mode = GPIO_MODE_OUTPUT_OD;
+        init.Pull = GPIO_PULLUP;  // weak, 400 kHz needs external pull-ups
+        init.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+        HAL_GPIO_Init(port(), &init);
+        u8x8_delay_init();
+    }
+
+    static void start(u8x8_t *u8x8)
+    {
+        half = (SystemCoreClock / 2000U + KHZ - 1U) / KHZ;
+        failed = false;
+        mark = DWT->CYCCNT;
+        // repeated START if a transfer was left open
+        port()->BSRR = SDA;
+        sclRelease();
+        edge();
+        port()->BSRR = uint32_t{SDA} << 16;
+        edge();
+        port()->BSRR = uint32_t{SCL} << 16;
+        writeByte(u8x8_GetI2CAddress(u8x8));
+    }
+
+    static void send(u8x8_t *, const uint8_t *data, uint8_t len)
+    {
+        while(len-- > 0U && !failed)
+        {
+            writeByte(*data++);
+        }
+    }
+
+    static void flush()
+    {
+        port()->BSRR = uint32_t{SDA} << 16;
+        edge();
+        sclRelease();
+        edge();
+        port()->BSRR = SDA;
+        edge();
+    }
+
+private:
+    static inline uint32_t half;
+    static inline uint32_t mark;
+    static inline bool failed;
+
+    static GPIO_TypeDef* port() { return reinterpret_cast<GPIO_TypeDef*>(PORT); }
+
+    static inline __attribute__((always_inline)) void edge()
+    {
+        while((DWT->CYCCNT - mark) < half) {}
+        mark = DWT->CYCCNT;
+    }
+
+    static inline __attribute__((always_inline)) void sclRelease()
+    {
+        port()->BSRR = SCL;
+        if((port()->IDR & SCL) != 0U)
+        {
+            return;
+        }
+        const uint32_t since = DWT->CYCCNT;
+        while((port()->IDR & SCL) == 0U)
+        {
+            if((DWT->CYCCNT - since) > SystemCoreClock / 1000U)
+            {
+                u8x8_stats.timeouts++;
+                failed = true;
+                return;
+            }
+        }
+        mark = DWT->CYCCNT;  // the high half starts when the slave lets go
+    }
+
+    // SCL is low on entry and on return
+    static inline __attribute__((always_inline)) void writeByte(uint8_t b)
+    {
+        for(uint_fast8_t n = 0U; n < 8U && !failed; n++, b <<= 1)
+        {
+            port()->BSRR = (b & 0x80U) ? SDA : (uint32_t{SDA} << 16);
+            edge();
+            sclRelease();
+            edge();
+            port()->BSRR = uint32_t{SCL} << 16;
+        }
+        if(failed)
+        {
+            return;  // SCL timed out, the slave is not listening
+        }
+        port()->BSRR = SDA;
+        edge();
+        sclRelease();
+        edge();
+        if((port()->IDR & SDA) != 0U)
+        {
+            u8x8_stats.errors++;
+            failed = true;
+        }
+        port()->BSRR = uint32_t{SCL} << 16;
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,148 @@
+/*
+ * u8g2_sw_spi.hpp
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: Władysław Ostrowski
+ */
+
+/*
+ This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef U8G2_SW_SPI_HPP
+#define U8G2_SW_SPI_HPP
+
+#include "u8g2_io.h"
+#include <cstdint>
+#include <utility>
+
+namespace u8g2lib {
+
+/*
+ * Software SPI bus for IoPolicy (see u8g2_policy.hpp). Shifts whole bytes
+ * with BSRR stores instead of going through u8x8_gpio_and_delay for every
+ * clock edge. Data and the "away from sample" clock edge share one store,
+ * the sample edge is the second one.
+ *
+ * start() turns the panel's sck_clock_hz, sck_pulse_width_ns and
+ * sda_setup_time_ns into a half period in core cycles at the current
+ * SystemCoreClock. If that is longer than a store takes, every edge waits
+ * for the DWT cycle counter like SwI2cBus does; otherwise the bits go out
+ * back to back, which is as fast as the port can toggle.
+ */
+template<uintptr_t PORT, uint16_t CLK, uint16_t MOSI>
+struct SwSpiBus
+{
+    static void init(u8x8_t *u8x8)
+    {
+        GPIO_InitTypeDef init = {0};
+        init.Pin = CLK | MOSI;
+        init.Mode = GPIO_MODE_OUTPUT_PP;
+        init.Pull = GPIO_NOPULL;
+        init.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+        HAL_GPIO_Init(port(), &init);
+        idle(u8x8->display_info->spi_mode);
+        u8x8_delay_init();
+    }
+
+    static void start(u8x8_t *u8x8)
+    {
+        const auto *info = u8x8->display_info;
+        uint32_t cycles = 0U;
+        if(info->sck_clock_hz != 0U)
+        {
+            cycles = (SystemCoreClock / 2U + info->sck_clock_hz - 1U) / info->sck_clock_hz;
+        }
+        cycles = longest(cycles, nsToCycles(info->sck_pulse_width_ns));
+        cycles = longest(cycles, nsToCycles(info->sda_setup_time_ns));
+        half = (cycles > STORE_CYCLES) ? cycles : 0U;
+    }
+
+    static inline __attribute__((always_inline)) void send(u8x8_t *u8x8, const uint8_t *data, uint8_t len)
+    {
+        const auto mode = u8x8->display_info->spi_mode;
+        // modes 0 and 3 sample on the rising edge, 1 and 2 on the falling one
+        const bool rising = (mode == 0U) || (mode == 3U);
+        const uint32_t pre = rising ? (uint32_t{CLK} << 16) : CLK;
+        const uint32_t edge = rising ? CLK : (uint32_t{CLK} << 16);
+        if(half == 0U)
+        {
+            while(len-- > 0U)
+            {
+                shiftOut<false>(*data++, pre, edge, std::make_index_sequence<8>{});
+            }
+        }
+        else
+        {
+            mark = DWT->CYCCNT;
+            while(len-- > 0U)
+            {
+                shiftOut<true>(*data++, pre, edge, std::make_index_sequence<8>{});
+            }
+        }
+        idle(mode);
+    }
+
+    static void flush() {}
+
+private:
+    // a BSRR store and the loop around it, shorter half periods need no wait
+    static constexpr uint32_t STORE_CYCLES = 2U;
+
+    static inline uint32_t half;
+    static inline uint32_t mark;
+
+    static GPIO_TypeDef* port() { return reinterpret_cast<GPIO_TypeDef*>(PORT); }
+
+    static void idle(const uint8_t mode) { port()->BSRR = (mode & 2U) ? CLK : (uint32_t{CLK} << 16); }
+
+    static uint32_t longest(const uint32_t a, const uint32_t b) { return (a > b) ? a : b; }
+
+    static uint32_t nsToCycles(const uint32_t ns)
+    {
+        return (ns * (SystemCoreClock / 1000000U) + 999U) / 1000U;
+    }
+
+    static inline __attribute__((always_inline)) void halfPeriod()
+    {
+        while((DWT->CYCCNT - mark) < half) {}
+        mark = DWT->CYCCNT;
+    }
+
+    template<bool TIMED, std::size_t BIT>
+    static inline __attribute__((always_inline)) void shiftBit(const uint8_t b, const uint32_t pre, const uint32_t edge)
+    {
+        constexpr uint8_t mask = 0x80U >> BIT;
+        port()->BSRR = pre | ((b & mask) ? MOSI : (uint32_t{MOSI} << 16));
+        if constexpr(TIMED)
+        {
+            halfPeriod();
+        }
+        port()->BSRR = edge;
+        if constexpr(TIMED)
+        {
+            halfPeriod();
+        }
+    }
+
+    template<bool TIMED, std::size_t... BITS>
+    static inline __attribute__((always_inline)) void shiftOut(const uint8_t b, const uint32_t pre, const uint32_t edge, std::index_sequence<BITS...>)
+    {
+        (shiftBit<TIMED, BITS>(b, pre, edge), ...);
+    }
+};
+
+}
+
+#endif
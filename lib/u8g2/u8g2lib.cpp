@@ -29,7 +29,7 @@ namespace u8g2lib {
 template<>
 U8G2<CHIP_TYPE::SSD1305, INTERFACE::SPI_4W_SW, DISPLAY::NONAME_128x32, MODE::HALF_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
 {
-    u8g2_Setup_ssd1305_128x32_noname_1(&u8g2, rotation, u8x8_byte_4wire_sw_spi, u8x8_gpio_and_delay);
+    u8g2_Setup_ssd1305_128x32_noname_1(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
 }
 
 /*
@@ -38,87 +38,192 @@ U8G2<CHIP_TYPE::SSD1305, INTERFACE::SPI_4W_SW, DISPLAY::NONAME_128x32, MODE::HAL
 template<>
 U8G2<CHIP_TYPE::SH1106, INTERFACE::SPI_4W_SW, DISPLAY::NONAME_128x64, MODE::HALF_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
 {
-    u8g2_Setup_sh1106_128x64_noname_1(&u8g2, rotation, u8x8_byte_4wire_sw_spi, u8x8_gpio_and_delay);
+    u8g2_Setup_sh1106_128x64_noname_1(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
 }
 
 template<>
 U8G2<CHIP_TYPE::SH1106, INTERFACE::SPI_4W_HW, DISPLAY::NONAME_128x64, MODE::HALF_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
 {
-    u8g2_Setup_sh1106_128x64_noname_1(&u8g2, rotation, u8x8_byte_hw_spi, u8x8_gpio_and_delay);
+    u8g2_Setup_sh1106_128x64_noname_1(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SH1106, INTERFACE::SPI_HW_DMA, DISPLAY::NONAME_128x64, MODE::HALF_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_sh1106_128x64_noname_1(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SH1106, INTERFACE::SPI_HW_IT, DISPLAY::NONAME_128x64, MODE::HALF_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_sh1106_128x64_noname_1(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
 }
 
 template<>
 U8G2<CHIP_TYPE::SH1106, INTERFACE::SPI_4W_SW, DISPLAY::NONAME_128x64, MODE::FULL_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
 {
-    u8g2_Setup_sh1106_128x64_noname_2(&u8g2, rotation, u8x8_byte_4wire_sw_spi, u8x8_gpio_and_delay);
+    u8g2_Setup_sh1106_128x64_noname_2(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
 }
 
 template<>
 U8G2<CHIP_TYPE::SH1106, INTERFACE::SPI_4W_HW, DISPLAY::NONAME_128x64, MODE::FULL_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
 {
-   u8g2_Setup_sh1106_128x64_noname_2(&u8g2, rotation, u8x8_byte_hw_spi, u8x8_gpio_and_delay );
+   u8g2_Setup_sh1106_128x64_noname_2(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SH1106, INTERFACE::SPI_HW_DMA, DISPLAY::NONAME_128x64, MODE::FULL_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+   u8g2_Setup_sh1106_128x64_noname_2(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SH1106, INTERFACE::SPI_HW_IT, DISPLAY::NONAME_128x64, MODE::FULL_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+   u8g2_Setup_sh1106_128x64_noname_2(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SH1106, INTERFACE::SPI_HW_DMA, DISPLAY::NONAME_128x64, MODE::PIPELINED_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+   u8g2_Setup_sh1106_128x64_noname_2(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+   setupPipelinedPages();
 }
 
 
 template<>
 U8G2<CHIP_TYPE::SH1106, INTERFACE::SPI_4W_SW, DISPLAY::NONAME_128x64, MODE::FULL_BUFFER>::U8G2(const u8g2_cb_t *rotation): U8G2()
 {
-    u8g2_Setup_sh1106_128x64_noname_f(&u8g2, rotation, u8x8_byte_4wire_sw_spi, u8x8_gpio_and_delay);
+    u8g2_Setup_sh1106_128x64_noname_f(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
 }
 
 template<>
 U8G2<CHIP_TYPE::SH1106, INTERFACE::SPI_4W_HW, DISPLAY::NONAME_128x64, MODE::FULL_BUFFER>::U8G2(const u8g2_cb_t *rotation): U8G2()
 {
-   u8g2_Setup_sh1106_128x64_noname_f(&u8g2, rotation, u8x8_byte_hw_spi, u8x8_gpio_and_delay );
+   u8g2_Setup_sh1106_128x64_noname_f(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SH1106, INTERFACE::SPI_HW_DMA, DISPLAY::NONAME_128x64, MODE::FULL_BUFFER>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+   u8g2_Setup_sh1106_128x64_noname_f(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SH1106, INTERFACE::SPI_HW_IT, DISPLAY::NONAME_128x64, MODE::FULL_BUFFER>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+   u8g2_Setup_sh1106_128x64_noname_f(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
 }
 
 
 template<>
 U8G2<CHIP_TYPE::SH1106, INTERFACE::SPI_4W_SW, DISPLAY::WINSTAR_128x64, MODE::HALF_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
 {
-    u8g2_Setup_sh1106_128x64_winstar_1(&u8g2, rotation, u8x8_byte_4wire_sw_spi, u8x8_gpio_and_delay);
+    u8g2_Setup_sh1106_128x64_winstar_1(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
 }
 
 template<>
 U8G2<CHIP_TYPE::SH1106, INTERFACE::SPI_4W_HW, DISPLAY::WINSTAR_128x64, MODE::HALF_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
 {
-    u8g2_Setup_sh1106_128x64_winstar_1(&u8g2, rotation, u8x8_byte_hw_spi, u8x8_gpio_and_delay);
+    u8g2_Setup_sh1106_128x64_winstar_1(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SH1106, INTERFACE::SPI_HW_DMA, DISPLAY::WINSTAR_128x64, MODE::HALF_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_sh1106_128x64_winstar_1(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SH1106, INTERFACE::SPI_HW_IT, DISPLAY::WINSTAR_128x64, MODE::HALF_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_sh1106_128x64_winstar_1(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
 }
 
 template<>
 U8G2<CHIP_TYPE::SH1106, INTERFACE::SPI_4W_SW, DISPLAY::WINSTAR_128x64, MODE::FULL_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
 {
-    u8g2_Setup_sh1106_128x64_winstar_2(&u8g2, rotation, u8x8_byte_4wire_sw_spi, u8x8_gpio_and_delay);
+    u8g2_Setup_sh1106_128x64_winstar_2(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
 }
 
 template<>
 U8G2<CHIP_TYPE::SH1106, INTERFACE::SPI_4W_HW, DISPLAY::WINSTAR_128x64, MODE::FULL_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
 {
-   u8g2_Setup_sh1106_128x64_winstar_2(&u8g2, rotation, u8x8_byte_hw_spi, u8x8_gpio_and_delay );
+   u8g2_Setup_sh1106_128x64_winstar_2(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SH1106, INTERFACE::SPI_HW_DMA, DISPLAY::WINSTAR_128x64, MODE::FULL_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+   u8g2_Setup_sh1106_128x64_winstar_2(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SH1106, INTERFACE::SPI_HW_IT, DISPLAY::WINSTAR_128x64, MODE::FULL_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+   u8g2_Setup_sh1106_128x64_winstar_2(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SH1106, INTERFACE::SPI_HW_DMA, DISPLAY::WINSTAR_128x64, MODE::PIPELINED_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+   u8g2_Setup_sh1106_128x64_winstar_2(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+   setupPipelinedPages();
 }
 
 template<>
 U8G2<CHIP_TYPE::SH1106, INTERFACE::SPI_4W_SW, DISPLAY::VCOMH0_128x64, MODE::HALF_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
 {
-    u8g2_Setup_sh1106_128x64_vcomh0_1(&u8g2, rotation, u8x8_byte_4wire_sw_spi, u8x8_gpio_and_delay);
+    u8g2_Setup_sh1106_128x64_vcomh0_1(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
 }
 
 template<>
 U8G2<CHIP_TYPE::SH1106, INTERFACE::SPI_4W_HW, DISPLAY::VCOMH0_128x64, MODE::HALF_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
 {
-    u8g2_Setup_sh1106_128x64_vcomh0_1(&u8g2, rotation, u8x8_byte_hw_spi, u8x8_gpio_and_delay);
+    u8g2_Setup_sh1106_128x64_vcomh0_1(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SH1106, INTERFACE::SPI_HW_DMA, DISPLAY::VCOMH0_128x64, MODE::HALF_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_sh1106_128x64_vcomh0_1(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SH1106, INTERFACE::SPI_HW_IT, DISPLAY::VCOMH0_128x64, MODE::HALF_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_sh1106_128x64_vcomh0_1(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
 }
 
 template<>
 U8G2<CHIP_TYPE::SH1106, INTERFACE::SPI_4W_SW, DISPLAY::VCOMH0_128x64, MODE::FULL_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
 {
-    u8g2_Setup_sh1106_128x64_vcomh0_2(&u8g2, rotation, u8x8_byte_4wire_sw_spi, u8x8_gpio_and_delay);
+    u8g2_Setup_sh1106_128x64_vcomh0_2(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
 }
 
 template<>
 U8G2<CHIP_TYPE::SH1106, INTERFACE::SPI_4W_HW, DISPLAY::VCOMH0_128x64, MODE::FULL_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
 {
-   u8g2_Setup_sh1106_128x64_vcomh0_2(&u8g2, rotation, u8x8_byte_hw_spi, u8x8_gpio_and_delay );
+   u8g2_Setup_sh1106_128x64_vcomh0_2(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SH1106, INTERFACE::SPI_HW_DMA, DISPLAY::VCOMH0_128x64, MODE::FULL_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+   u8g2_Setup_sh1106_128x64_vcomh0_2(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SH1106, INTERFACE::SPI_HW_IT, DISPLAY::VCOMH0_128x64, MODE::FULL_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+   u8g2_Setup_sh1106_128x64_vcomh0_2(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SH1106, INTERFACE::SPI_HW_DMA, DISPLAY::VCOMH0_128x64, MODE::PIPELINED_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+   u8g2_Setup_sh1106_128x64_vcomh0_2(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+   setupPipelinedPages();
 }
 
 /*
@@ -127,51 +232,425 @@ U8G2<CHIP_TYPE::SH1106, INTERFACE::SPI_4W_HW, DISPLAY::VCOMH0_128x64, MODE::FULL
 template<>
 U8G2<CHIP_TYPE::SSD1306, INTERFACE::SPI_4W_SW, DISPLAY::NONAME_128x64, MODE::HALF_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
 {
-    u8g2_Setup_ssd1306_128x64_noname_1(&u8g2, rotation, u8x8_byte_4wire_sw_spi, u8x8_gpio_and_delay);
+    u8g2_Setup_ssd1306_128x64_noname_1(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
 }
 
 template<>
 U8G2<CHIP_TYPE::SSD1306, INTERFACE::SPI_4W_HW, DISPLAY::NONAME_128x64, MODE::HALF_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
 {
-    u8g2_Setup_ssd1306_128x64_noname_1(&u8g2, rotation, u8x8_byte_hw_spi, u8x8_gpio_and_delay);
+    u8g2_Setup_ssd1306_128x64_noname_1(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SSD1306, INTERFACE::SPI_HW_DMA, DISPLAY::NONAME_128x64, MODE::HALF_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_ssd1306_128x64_noname_1(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SSD1306, INTERFACE::SPI_HW_IT, DISPLAY::NONAME_128x64, MODE::HALF_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_ssd1306_128x64_noname_1(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
 }
 
 template<>
 U8G2<CHIP_TYPE::SSD1306, INTERFACE::SPI_4W_SW, DISPLAY::NONAME_128x64, MODE::FULL_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
 {
-    u8g2_Setup_ssd1306_128x64_noname_2(&u8g2, rotation, u8x8_byte_4wire_sw_spi, u8x8_gpio_and_delay);
+    u8g2_Setup_ssd1306_128x64_noname_2(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
 }
 
 template<>
 U8G2<CHIP_TYPE::SSD1306, INTERFACE::SPI_4W_HW, DISPLAY::NONAME_128x64, MODE::FULL_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
 {
-   u8g2_Setup_ssd1306_128x64_noname_2(&u8g2, rotation, u8x8_byte_hw_spi, u8x8_gpio_and_delay );
+   u8g2_Setup_ssd1306_128x64_noname_2(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SSD1306, INTERFACE::SPI_HW_DMA, DISPLAY::NONAME_128x64, MODE::FULL_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+   u8g2_Setup_ssd1306_128x64_noname_2(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SSD1306, INTERFACE::SPI_HW_IT, DISPLAY::NONAME_128x64, MODE::FULL_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+   u8g2_Setup_ssd1306_128x64_noname_2(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SSD1306, INTERFACE::SPI_HW_DMA, DISPLAY::NONAME_128x64, MODE::PIPELINED_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+   u8g2_Setup_ssd1306_128x64_noname_2(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+   setupPipelinedPages();
 }
 
 template<>
 U8G2<CHIP_TYPE::SSD1306, INTERFACE::SPI_4W_SW, DISPLAY::ALT0_128x64, MODE::HALF_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
 {
-    u8g2_Setup_ssd1306_128x64_alt0_1(&u8g2, rotation, u8x8_byte_4wire_sw_spi, u8x8_gpio_and_delay);
+    u8g2_Setup_ssd1306_128x64_alt0_1(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
 }
 
 template<>
 U8G2<CHIP_TYPE::SSD1306, INTERFACE::SPI_4W_HW, DISPLAY::ALT0_128x64, MODE::HALF_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
 {
-    u8g2_Setup_ssd1306_128x64_alt0_1(&u8g2, rotation, u8x8_byte_hw_spi, u8x8_gpio_and_delay);
+    u8g2_Setup_ssd1306_128x64_alt0_1(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SSD1306, INTERFACE::SPI_HW_DMA, DISPLAY::ALT0_128x64, MODE::HALF_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_ssd1306_128x64_alt0_1(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SSD1306, INTERFACE::SPI_HW_IT, DISPLAY::ALT0_128x64, MODE::HALF_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_ssd1306_128x64_alt0_1(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
 }
 
 template<>
 U8G2<CHIP_TYPE::SSD1306, INTERFACE::SPI_4W_SW, DISPLAY::ALT0_128x64, MODE::FULL_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
 {
-    u8g2_Setup_ssd1306_128x64_alt0_2(&u8g2, rotation, u8x8_byte_4wire_sw_spi, u8x8_gpio_and_delay);
+    u8g2_Setup_ssd1306_128x64_alt0_2(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
 }
 
 template<>
 U8G2<CHIP_TYPE::SSD1306, INTERFACE::SPI_4W_HW, DISPLAY::ALT0_128x64, MODE::FULL_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
 {
-   u8g2_Setup_ssd1306_128x64_alt0_2(&u8g2, rotation, u8x8_byte_hw_spi, u8x8_gpio_and_delay );
+   u8g2_Setup_ssd1306_128x64_alt0_2(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SSD1306, INTERFACE::SPI_HW_DMA, DISPLAY::ALT0_128x64, MODE::FULL_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+   u8g2_Setup_ssd1306_128x64_alt0_2(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SSD1306, INTERFACE::SPI_HW_IT, DISPLAY::ALT0_128x64, MODE::FULL_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+   u8g2_Setup_ssd1306_128x64_alt0_2(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SSD1306, INTERFACE::SPI_HW_DMA, DISPLAY::ALT0_128x64, MODE::PIPELINED_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+   u8g2_Setup_ssd1306_128x64_alt0_2(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+   setupPipelinedPages();
+}
+
+/*
+ * CRC-signed pages
+ */
+template<>
+U8G2<CHIP_TYPE::SH1106, INTERFACE::SPI_4W_HW, DISPLAY::NONAME_128x64, MODE::SIGNED_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_sh1106_128x64_noname_1(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SH1106, INTERFACE::SPI_HW_DMA, DISPLAY::NONAME_128x64, MODE::SIGNED_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_sh1106_128x64_noname_1(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SH1106, INTERFACE::I2C_HW, DISPLAY::NONAME_128x64, MODE::SIGNED_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_sh1106_i2c_128x64_noname_1(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SSD1306, INTERFACE::SPI_4W_HW, DISPLAY::NONAME_128x64, MODE::SIGNED_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_ssd1306_128x64_noname_1(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SSD1306, INTERFACE::SPI_HW_DMA, DISPLAY::NONAME_128x64, MODE::SIGNED_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_ssd1306_128x64_noname_1(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SSD1306, INTERFACE::I2C_HW, DISPLAY::NONAME_128x64, MODE::SIGNED_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_ssd1306_i2c_128x64_noname_1(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
 }
 
+/*
+ * Column-run diff
+ */
+template<>
+U8G2<CHIP_TYPE::SH1106, INTERFACE::SPI_4W_HW, DISPLAY::NONAME_128x64, MODE::DIFF_BUFFER>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_sh1106_128x64_noname_f(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+    u8g2_diff_attach(&u8g2);
+}
+
+template<>
+U8G2<CHIP_TYPE::SH1106, INTERFACE::SPI_HW_DMA, DISPLAY::NONAME_128x64, MODE::DIFF_BUFFER>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_sh1106_128x64_noname_f(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+    u8g2_diff_attach(&u8g2);
+}
+
+template<>
+U8G2<CHIP_TYPE::SH1106, INTERFACE::I2C_HW, DISPLAY::NONAME_128x64, MODE::DIFF_BUFFER>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_sh1106_i2c_128x64_noname_f(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+    u8g2_diff_attach(&u8g2);
+}
+
+template<>
+U8G2<CHIP_TYPE::SSD1306, INTERFACE::SPI_4W_HW, DISPLAY::NONAME_128x64, MODE::DIFF_BUFFER>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_ssd1306_128x64_noname_f(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+    u8g2_diff_attach(&u8g2);
+}
+
+template<>
+U8G2<CHIP_TYPE::SSD1306, INTERFACE::SPI_HW_DMA, DISPLAY::NONAME_128x64, MODE::DIFF_BUFFER>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_ssd1306_128x64_noname_f(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+    u8g2_diff_attach(&u8g2);
+}
+
+template<>
+U8G2<CHIP_TYPE::SSD1306, INTERFACE::I2C_HW, DISPLAY::NONAME_128x64, MODE::DIFF_BUFFER>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_ssd1306_i2c_128x64_noname_f(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+    u8g2_diff_attach(&u8g2);
+}
+
+/*
+ * 3-wire
+ */
+template<>
+U8G2<CHIP_TYPE::SH1106, INTERFACE::SPI_3W_HW, DISPLAY::NONAME_128x64, MODE::HALF_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_sh1106_128x64_noname_1(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SH1106, INTERFACE::SPI_3W_HW, DISPLAY::NONAME_128x64, MODE::FULL_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_sh1106_128x64_noname_2(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SH1106, INTERFACE::SPI_3W_HW, DISPLAY::NONAME_128x64, MODE::FULL_BUFFER>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_sh1106_128x64_noname_f(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SSD1306, INTERFACE::SPI_3W_HW, DISPLAY::NONAME_128x64, MODE::HALF_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_ssd1306_128x64_noname_1(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SSD1306, INTERFACE::SPI_3W_HW, DISPLAY::NONAME_128x64, MODE::FULL_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_ssd1306_128x64_noname_2(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SSD1306, INTERFACE::SPI_3W_HW, DISPLAY::NONAME_128x64, MODE::FULL_BUFFER>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_ssd1306_128x64_noname_f(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+/*
+ * Parallel
+ */
+template<>
+U8G2<CHIP_TYPE::SSD1306, INTERFACE::I8080, DISPLAY::NONAME_128x64, MODE::HALF_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_ssd1306_128x64_noname_1(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SSD1306, INTERFACE::I8080, DISPLAY::NONAME_128x64, MODE::FULL_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_ssd1306_128x64_noname_2(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SSD1306, INTERFACE::I8080, DISPLAY::NONAME_128x64, MODE::FULL_BUFFER>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_ssd1306_128x64_noname_f(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SSD1306, INTERFACE::M6800, DISPLAY::NONAME_128x64, MODE::HALF_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_ssd1306_128x64_noname_1(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SSD1306, INTERFACE::M6800, DISPLAY::NONAME_128x64, MODE::FULL_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_ssd1306_128x64_noname_2(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SSD1306, INTERFACE::M6800, DISPLAY::NONAME_128x64, MODE::FULL_BUFFER>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_ssd1306_128x64_noname_f(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+/*
+ * Sharp memory LCD
+ */
+template<>
+U8G2<CHIP_TYPE::LS013B7DH03, INTERFACE::SPI_4W_HW, DISPLAY::NONAME_128x128, MODE::FULL_BUFFER>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_ls013b7dh03_128x128_f(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+    u8g2_memlcd_attach(&u8g2);
+}
+
+template<>
+U8G2<CHIP_TYPE::LS013B7DH03, INTERFACE::SPI_HW_DMA, DISPLAY::NONAME_128x128, MODE::FULL_BUFFER>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_ls013b7dh03_128x128_f(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+    u8g2_memlcd_attach(&u8g2);
+}
+
+template<>
+U8G2<CHIP_TYPE::LS027B7DH01, INTERFACE::SPI_4W_HW, DISPLAY::NONAME_400x240, MODE::FULL_BUFFER>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_ls027b7dh01_400x240_f(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+    u8g2_memlcd_attach(&u8g2);
+}
+
+template<>
+U8G2<CHIP_TYPE::LS027B7DH01, INTERFACE::SPI_HW_DMA, DISPLAY::NONAME_400x240, MODE::FULL_BUFFER>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_ls027b7dh01_400x240_f(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+    u8g2_memlcd_attach(&u8g2);
+}
+
+/*
+ * E-paper
+ */
+template<>
+U8G2<CHIP_TYPE::IL3820, INTERFACE::SPI_4W_HW, DISPLAY::NONAME_296x128, MODE::FULL_BUFFER>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_il3820_296x128_f(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+    u8g2_epaper_attach(&u8g2, 1U);
+}
+
+template<>
+U8G2<CHIP_TYPE::IL3820, INTERFACE::SPI_HW_DMA, DISPLAY::NONAME_296x128, MODE::FULL_BUFFER>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_il3820_296x128_f(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+    u8g2_epaper_attach(&u8g2, 1U);
+}
+
+template<>
+U8G2<CHIP_TYPE::SSD1606, INTERFACE::SPI_4W_HW, DISPLAY::NONAME_172x72, MODE::FULL_BUFFER>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_ssd1606_172x72_f(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+    u8g2_epaper_attach(&u8g2, 0U);
+}
+
+template<>
+U8G2<CHIP_TYPE::SSD1606, INTERFACE::SPI_HW_DMA, DISPLAY::NONAME_172x72, MODE::FULL_BUFFER>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_ssd1606_172x72_f(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+    u8g2_epaper_attach(&u8g2, 0U);
+}
+
+template<>
+U8G2<CHIP_TYPE::SSD1607, INTERFACE::SPI_4W_HW, DISPLAY::NONAME_200x200, MODE::FULL_BUFFER>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_ssd1607_200x200_f(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+    u8g2_epaper_attach(&u8g2, 1U);
+}
+
+template<>
+U8G2<CHIP_TYPE::SSD1607, INTERFACE::SPI_HW_DMA, DISPLAY::NONAME_200x200, MODE::FULL_BUFFER>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_ssd1607_200x200_f(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+    u8g2_epaper_attach(&u8g2, 1U);
+}
+
+/*
+ * I2C
+ */
+template<>
+U8G2<CHIP_TYPE::SH1106, INTERFACE::I2C_HW, DISPLAY::NONAME_128x64, MODE::HALF_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_sh1106_i2c_128x64_noname_1(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SH1106, INTERFACE::I2C_HW, DISPLAY::NONAME_128x64, MODE::FULL_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_sh1106_i2c_128x64_noname_2(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SH1106, INTERFACE::I2C_HW, DISPLAY::NONAME_128x64, MODE::FULL_BUFFER>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_sh1106_i2c_128x64_noname_f(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SSD1306, INTERFACE::I2C_HW, DISPLAY::NONAME_128x64, MODE::HALF_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_ssd1306_i2c_128x64_noname_1(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SSD1306, INTERFACE::I2C_HW, DISPLAY::NONAME_128x64, MODE::FULL_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_ssd1306_i2c_128x64_noname_2(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SSD1306, INTERFACE::I2C_HW, DISPLAY::NONAME_128x64, MODE::FULL_BUFFER>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_ssd1306_i2c_128x64_noname_f(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SH1106, INTERFACE::I2C_SW, DISPLAY::NONAME_128x64, MODE::HALF_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_sh1106_i2c_128x64_noname_1(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SH1106, INTERFACE::I2C_SW, DISPLAY::NONAME_128x64, MODE::FULL_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_sh1106_i2c_128x64_noname_2(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SH1106, INTERFACE::I2C_SW, DISPLAY::NONAME_128x64, MODE::FULL_BUFFER>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_sh1106_i2c_128x64_noname_f(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SSD1306, INTERFACE::I2C_SW, DISPLAY::NONAME_128x64, MODE::HALF_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_ssd1306_i2c_128x64_noname_1(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SSD1306, INTERFACE::I2C_SW, DISPLAY::NONAME_128x64, MODE::FULL_PAGE>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_ssd1306_i2c_128x64_noname_2(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
+
+template<>
+U8G2<CHIP_TYPE::SSD1306, INTERFACE::I2C_SW, DISPLAY::NONAME_128x64, MODE::FULL_BUFFER>::U8G2(const u8g2_cb_t *rotation): U8G2()
+{
+    u8g2_Setup_ssd1306_i2c_128x64_noname_f(&u8g2, rotation, IO::byte_cb, IO::gpio_cb);
+}
 
 
 template<CHIP_TYPE ICT, INTERFACE IO_TYPE, DISPLAY D_NAME, MODE MODE>
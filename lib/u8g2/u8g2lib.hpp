@@ -24,7 +24,11 @@
 #define U8G2_U8G2LIB_HPP
 
 #include "u8g2/csrc/u8g2.h"
+#include "u8g2_io.h"
+#include "u8g2_policy.hpp"
 #include "Print.hpp"
+#include <array>
+#include <initializer_list>
 
 namespace u8g2lib {
 
@@ -68,19 +72,49 @@ enum class DISPLAY
     NONE, NONAME_60x32, NONAME_64x32, NONAME_64x48, NONAME_96x16, NONAME_96x96,
     NONAME_128x32,
     ADAFRUIT_128x32, NONAME_128x64, NONAME_128x96, NONAME_128x128
-    , NONAME_192x32, WINSTAR_128x64, VCOMH0_128x64, ALT0_128x64
+    , NONAME_192x32, WINSTAR_128x64, VCOMH0_128x64, ALT0_128x64, NONAME_400x240
+    , NONAME_172x72, NONAME_200x200, NONAME_296x128
 };
 
 enum class MODE
 {
     HALF_PAGE,   // Use a firstPage()/nextPage() loop for drawing on the display.
     FULL_PAGE,   // same as HALF_PAGE but keeps full frame in RAM
+    PIPELINED_PAGE, // FULL_PAGE RAM split into two HALF_PAGE buffers: nextPage()
+                    // hands one to the DMA transport and renders into the other
+    SIGNED_PAGE, // HALF_PAGE that keeps a CRC of every page sent; nextPage()
+                 // skips pages that render the same as in the previous frame
+    DIFF_BUFFER, // FULL_BUFFER plus a copy of the controller RAM; sendBuffer()
+                 // sends only the column runs that changed (SH1106, SSD1306)
     FULL_BUFFER, //Keep a copy of the full display frame buffer in the RAM.
                  //Use clearBuffer() to clear the RAM
                  //and sendBuffer() to transfer the RAM to the display.
     U8x8         // character only mode
 };
 
+/*
+ * Transport counters of the last frame, i.e. firstPage() up to the
+ * nextPage() that returned false, or one sendBuffer().
+ */
+struct FrameStats
+{
+    u8x8_stats_t bus;
+    uint32_t pages;
+    uint32_t cycles;
+};
+
+// transport selected by INTERFACE at compile time
+template<INTERFACE> struct Io;
+template<> struct Io<INTERFACE::SPI_4W_SW> : IoPolicy<BoardSwSpiBus, BoardPins> {};
+template<> struct Io<INTERFACE::SPI_4W_HW> : IoPolicy<HalSpiBus, BoardPins> {};
+template<> struct Io<INTERFACE::SPI_3W_HW> : CIo<u8x8_byte_hw_spi_3w> {};
+template<> struct Io<INTERFACE::SPI_HW_IT> : CIo<u8x8_byte_hw_spi_it> {};
+template<> struct Io<INTERFACE::SPI_HW_DMA> : CIo<u8x8_byte_hw_spi_dma> {};
+template<> struct Io<INTERFACE::I2C_SW> : IoPolicy<BoardSwI2cBus, BoardI2cPins> {};
+template<> struct Io<INTERFACE::I2C_HW> : CIo<u8x8_byte_hw_i2c> {};
+template<> struct Io<INTERFACE::I8080> : IoPolicy<BoardI8080Bus, BoardPins> {};
+template<> struct Io<INTERFACE::M6800> : IoPolicy<BoardM6800Bus, BoardPins> {};
+
 using Print::Print;
 
 void u8g2_SetPageCurrTileRow(const u8g2_t *, const uint8_t);
@@ -90,6 +124,22 @@ template<CHIP_TYPE ICT, INTERFACE IO_TYPE, DISPLAY D_NAME, MODE M>
 class U8G2: public Print
 {
 public:
+    using IO = Io<IO_TYPE>;
+    // page/column commands of these controllers go through u8x8_byte_shadow
+    static constexpr bool SHADOWED = (ICT == CHIP_TYPE::SH1106 || ICT == CHIP_TYPE::SSD1306)
+        && IO_TYPE != INTERFACE::I2C_HW && IO_TYPE != INTERFACE::I2C_SW;
+    // columns of controller RAM, the column pointer wraps after the last
+    static constexpr uint8_t RAM_COLUMNS = ICT == CHIP_TYPE::SH1106 ? 132U : 128U;
+    // SSD1306 runs in horizontal addressing mode, the wrap moves on to the next page
+    static constexpr bool RAM_HORIZONTAL = ICT == CHIP_TYPE::SSD1306;
+    // Sharp memory LCDs send only the scanlines that changed
+    static constexpr bool MEMLCD = ICT == CHIP_TYPE::LS013B7DH03 || ICT == CHIP_TYPE::LS027B7DH01;
+    // e-paper sends the changed window and returns, BUSY is watched on EXTI
+    static constexpr bool EPAPER = ICT == CHIP_TYPE::IL3820 || ICT == CHIP_TYPE::SSD1606
+        || ICT == CHIP_TYPE::SSD1607;
+    // other full buffer displays track a dirty tile rectangle for sendDirty()
+    static constexpr bool DIRTY = M == MODE::FULL_BUFFER && !MEMLCD && !EPAPER;
+
     U8G2(const u8g2_cb_t *rotation);
     U8G2(const U8G2&) = delete;
     U8G2(const U8G2&&) = delete;
@@ -104,23 +154,250 @@ public:
 
     void begin()
     {
-        u8g2_InitDisplay(&u8g2);
-        u8g2_ClearDisplay(&u8g2);
-        u8g2_SetPowerSave(&u8g2, 0U);
+        initDisplay();
+        if constexpr (EPAPER)
+        {
+            // blanked by a full refresh that doesn't wait for it to end
+            setPowerSave(0U);
+            u8g2_ClearBuffer(&u8g2);
+            refreshFull();
+            return;
+        }
+        clearDisplay();
+        setPowerSave(0U);
+        if constexpr (MEMLCD)
+        {
+            u8g2_memlcd_vcom_start();
+        }
     }
 
-    void initDisplay() { u8g2_InitDisplay(&u8g2); }
+    /*
+     * Non-blocking begin(). The reset pulse and settle time are timed with
+     * HAL_GetTick() from pollBegin(); after that the init sequence, clear
+     * and power-on are recorded into one DMA frame and streamed while the
+     * caller goes on. Call pollBegin() until it returns true, onReady runs
+     * from there once the display is up. Transports other than SPI_HW_DMA
+     * run begin() and are ready on return, and so do e-paper panels: their
+     * clear is a refresh that has to wait for BUSY, which a recorded frame
+     * cannot do.
+     */
+    void beginAsync(void (*onReady)() = nullptr)
+    {
+        bootDone = onReady;
+        if constexpr (IO_TYPE != INTERFACE::SPI_HW_DMA || EPAPER)
+        {
+            begin();
+            bootEnter(Boot::READY);
+        }
+        else
+        {
+            auto *u8x8 = u8g2_GetU8x8(&u8g2);
+            if constexpr (SHADOWED)
+            {
+                u8x8_shadow_attach(u8x8, RAM_COLUMNS, RAM_HORIZONTAL);
+            }
+            if constexpr (DIRTY)
+            {
+                u8g2_dirty_mark_all(&u8g2);
+            }
+            u8x8_gpio_call(u8x8, U8X8_MSG_GPIO_AND_DELAY_INIT, 0U);
+            u8x8_gpio_SetReset(u8x8, 1U);
+            bootEnter(Boot::PULSE_HIGH);
+        }
+    }
+
+    bool pollBegin()
+    {
+        const auto *info = u8g2_GetU8x8(&u8g2)->display_info;
+        const uint32_t elapsed = HAL_GetTick() - bootAt;
+        switch(boot)
+        {
+            case Boot::PULSE_HIGH:
+                if(elapsed > info->reset_pulse_width_ms)
+                {
+                    u8x8_gpio_SetReset(u8g2_GetU8x8(&u8g2), 0U);
+                    bootEnter(Boot::PULSE_LOW);
+                }
+                break;
+            case Boot::PULSE_LOW:
+                if(elapsed > info->reset_pulse_width_ms)
+                {
+                    u8x8_gpio_SetReset(u8g2_GetU8x8(&u8g2), 1U);
+                    bootEnter(Boot::SETTLE);
+                }
+                break;
+            case Boot::SETTLE:
+                if(elapsed > info->post_reset_wait_ms)
+                {
+                    bootRecord();
+                    bootEnter(Boot::SENDING);
+                }
+                break;
+            case Boot::SENDING:
+                if constexpr (IO_TYPE == INTERFACE::SPI_HW_DMA)
+                {
+                    if(0U != u8x8_hw_spi_dma_done(bootTicket))
+                    {
+                        if constexpr (MEMLCD)
+                        {
+                            u8g2_memlcd_vcom_start();
+                        }
+                        bootEnter(Boot::READY);
+                    }
+                }
+                break;
+            default:
+                break;
+        }
+        return boot == Boot::READY;
+    }
+    bool isReady() const { return boot == Boot::READY; }
+
+    void initDisplay()
+    {
+        if constexpr (SHADOWED)
+        {
+            u8x8_shadow_attach(u8g2_GetU8x8(&u8g2), RAM_COLUMNS, RAM_HORIZONTAL);
+        }
+        if constexpr (DIRTY)
+        {
+            u8g2_dirty_mark_all(&u8g2);
+        }
+        u8g2_InitDisplay(&u8g2);
+        contrast = powerSave = flipMode = UNKNOWN;
+        forgetRam();
+        startLine = 0U;
+        hScroll = false;
+    }
     void clear() { home(); clearDisplay(); clearBuffer(); }
-    void clearDisplay() { u8g2_ClearDisplay(&u8g2); }
-    void setPowerSave(const uint8_t is_enable) { u8g2_SetPowerSave(&u8g2, is_enable); }
-    void setFlipMode(const uint8_t mode) { u8g2_SetFlipMode(&u8g2, mode); }
-    void noDisplay() { u8g2_SetPowerSave(&u8g2, 1U); }
-    void display() { u8g2_SetPowerSave(&u8g2, 0U); }
+    void clearDisplay()
+    {
+        if constexpr (IO_TYPE == INTERFACE::SPI_HW_DMA && !MEMLCD && !EPAPER)
+        {
+            fillDisplay(0U);
+        }
+        else
+        {
+            u8g2_ClearDisplay(&u8g2);
+            forgetRam();
+        }
+    }
+    // every tile of the controller RAM set to pattern, the buffer is left alone;
+    // not for memory LCD and e-paper, whose line addresses and RAM commands
+    // are sent as data bytes that a fill run would replace with the pattern
+    void fillDisplay(const uint8_t pattern)
+    {
+        static_assert(!MEMLCD && !EPAPER,
+            "fillDisplay(): memory LCD and e-paper send their addressing as data, "
+            "a DMA fill run would overwrite it with the pattern; use clearDisplay()");
+        auto *u8x8 = u8g2_GetU8x8(&u8g2);
+        forgetRam();
+        if constexpr (IO_TYPE == INTERFACE::SPI_HW_DMA)
+        {
+            // data bytes go out as DMA fill runs, only the addressing is recorded
+            u8x8_hw_spi_dma_frame_begin();
+            u8x8_hw_spi_dma_fill_begin(pattern);
+            u8x8_ClearDisplay(u8x8);
+            u8x8_hw_spi_dma_fill_end();
+            u8x8_hw_spi_dma_frame_end();
+        }
+        else
+        {
+            const uint8_t tile[8] = {pattern, pattern, pattern, pattern, pattern, pattern, pattern, pattern};
+            u8x8_ClearDisplayWithTile(u8x8, tile);
+        }
+    }
+    // repeated calls with the value the controller already has send nothing
+    void setPowerSave(const uint8_t is_enable)
+    {
+        if(powerSave != is_enable)
+        {
+            u8g2_SetPowerSave(&u8g2, is_enable);
+            powerSave = is_enable;
+        }
+    }
+    void setFlipMode(const uint8_t mode)
+    {
+        if(flipMode != mode)
+        {
+            u8g2_SetFlipMode(&u8g2, mode);
+            flipMode = mode;
+            forgetRam();
+        }
+    }
+    void noDisplay() { setPowerSave(1U); }
+    void display() { setPowerSave(0U); }
     void setContrast(const uint8_t value)
     {
-        u8g2_SetContrast(&u8g2, value);
+        if(contrast != value)
+        {
+            u8g2_SetContrast(&u8g2, value);
+            contrast = value;
+        }
     }
     void setDisplayRotation(const u8g2_cb_t *u8g2_cb) {u8g2_SetDisplayRotation(&u8g2, u8g2_cb); }
+
+    /*
+     * Hardware scrolling (SSD1306, SH1106). The panel shows controller RAM
+     * from the display start line on, wrapping at the bottom, so
+     * scrollVertical() moves the whole picture by one command. The buffer
+     * keeps the RAM layout: screen row y is buffer row bufferRow(y). Draw
+     * the rows that scrolled in there and send just those with sendRows(),
+     * e.g. a text terminal scrolls by 8 and sends one page instead of all.
+     */
+    void scrollVertical(const int16_t lines)
+    {
+        static_assert(ICT == CHIP_TYPE::SSD1306 || ICT == CHIP_TYPE::SH1106, "no start line command");
+        const int16_t h = u8g2_GetU8x8(&u8g2)->display_info->pixel_height;
+        startLine = static_cast<uint8_t>(((startLine + lines) % h + h) % h);
+        sendCommands({static_cast<uint8_t>(0x40U | startLine)});
+    }
+    u8g2_uint_t bufferRow(const u8g2_uint_t screenRow) const
+    {
+        return (screenRow + startLine) % u8g2_GetU8x8(&u8g2)->display_info->pixel_height;
+    }
+    // buffer rows [y, y + h) and whatever else shares their pages, wrapping at the bottom
+    void sendRows(const u8g2_uint_t y, const u8g2_uint_t h)
+    {
+        const uint8_t rows = u8g2_GetU8x8(&u8g2)->display_info->tile_height;
+        const uint16_t first = y / 8U;
+        const uint16_t count = (y + h + 7U) / 8U - first;
+        sendTileRows(static_cast<uint8_t>(first), static_cast<uint8_t>(count < rows ? count : rows));
+    }
+
+    /*
+     * SSD1306 continuous horizontal scroll of pages firstPage..lastPage, one
+     * column every interval (command code: 7 = 2 frames ... 3 = 256 frames).
+     * The controller moves the data around in its RAM, so RAM must not be
+     * written until stopScroll(), which puts the buffer back on those pages.
+     */
+    void scrollHorizontal(const bool left, const uint8_t firstPage, const uint8_t lastPage, const uint8_t interval = 7U)
+    {
+        static_assert(ICT == CHIP_TYPE::SSD1306, "no horizontal scroll command");
+        if(hScroll)
+        {
+            sendCommands({0x2EU});
+        }
+        sendCommands({static_cast<uint8_t>(left ? 0x27U : 0x26U), 0x00U, firstPage, interval, lastPage, 0x00U, 0xFFU, 0x2FU});
+        hScroll = true;
+        hScrollPages[0] = firstPage;
+        hScrollPages[1] = lastPage;
+    }
+    void stopScroll()
+    {
+        if(!hScroll)
+        {
+            return;
+        }
+        sendCommands({0x2EU});
+        hScroll = false;
+        forgetRam();
+        if constexpr (M == MODE::FULL_BUFFER)
+        {
+            sendTileRows(hScrollPages[0], static_cast<uint8_t>(hScrollPages[1] - hScrollPages[0] + 1U));
+        }
+    }
+
     void home()
     {
         setCursor();
@@ -128,13 +405,103 @@ public:
     }
 
     /* u8g2_buffer.c */
-    void sendBuffer() { u8g2_SendBuffer(&u8g2); }
-    void clearBuffer() { u8g2_ClearBuffer(&u8g2); }
+    void sendBuffer()
+    {
+        frameStart();
+        if constexpr (IO_TYPE == INTERFACE::SPI_HW_DMA)
+        {
+            // recorded and sent as one stream, the buffer is free on return
+            recordBegin();
+            sendFrame();
+            recordEnd();
+        }
+        else
+        {
+            sendFrame();
+        }
+        frameEnd();
+    }
+    // only the tiles drawn or cleared since the last send, as one rectangle;
+    // the first call sends everything and starts the tracking
+    void sendDirty()
+    {
+        static_assert(DIRTY, "needs MODE::FULL_BUFFER, memory LCD and e-paper track their own");
+        frameStart();
+        if constexpr (IO_TYPE == INTERFACE::SPI_HW_DMA)
+        {
+            recordBegin();
+            u8g2_dirty_send(&u8g2);
+            recordEnd();
+        }
+        else
+        {
+            u8g2_dirty_send(&u8g2);
+        }
+        frameEnd();
+    }
+    void clearBuffer()
+    {
+        if constexpr (MEMLCD)
+        {
+            u8g2_memlcd_clear(&u8g2);
+        }
+        else if constexpr (EPAPER)
+        {
+            u8g2_epaper_clear(&u8g2);
+        }
+        else if constexpr (DIRTY)
+        {
+            u8g2_dirty_clear(&u8g2);
+        }
+        else
+        {
+            u8g2_ClearBuffer(&u8g2);
+        }
+    }
+    // after writing through getBufferPtr(), which drawing calls can't see
+    void invalidateBuffer()
+    {
+        if constexpr (MEMLCD)
+        {
+            u8g2_memlcd_mark_all(&u8g2);
+        }
+        if constexpr (EPAPER)
+        {
+            u8g2_epaper_mark_all(&u8g2);
+        }
+        if constexpr (DIRTY)
+        {
+            u8g2_dirty_mark_all(&u8g2);
+        }
+        forgetRam();
+    }
+    // e-paper: whole panel with the full waveform, clears partial refresh ghosting
+    void refreshFull()
+    {
+        u8g2_epaper_mark_all(&u8g2);
+        sendBuffer();
+    }
 
-    void firstPage() { u8g2_FirstPage(&u8g2); }
+    void firstPage()
+    {
+        frameStart();
+        u8g2_FirstPage(&u8g2);
+    }
     bool nextPage()
      {
-         auto ret = 0U != u8g2_NextPage(&u8g2);
+         auto ret = false;
+         if constexpr (M == MODE::PIPELINED_PAGE)
+         {
+             ret = 0U != nextPipelinedPage();
+         }
+         else if constexpr (M == MODE::SIGNED_PAGE)
+         {
+             ret = 0U != nextSignedPage();
+         }
+         else
+         {
+             ret = 0U != u8g2_NextPage(&u8g2);
+         }
          if(ret)
          {
              tx = rTx;
@@ -145,9 +512,69 @@ public:
              rTx = tx;
              rTy = ty;
          }
+         framePages++;
+         if(!ret)
+         {
+             frameEnd();
+         }
          return ret;
      }
 
+    // asynchronous transports return before the last bytes are on the wire
+    bool isBusy() const
+    {
+        if constexpr (EPAPER)
+        {
+            if(0U != u8g2_epaper_is_busy())
+            {
+                return true;
+            }
+        }
+        if constexpr (IO_TYPE == INTERFACE::SPI_HW_DMA)
+        {
+            return 0U != u8x8_hw_spi_dma_is_busy();
+        }
+        if constexpr (IO_TYPE == INTERFACE::SPI_3W_HW)
+        {
+            return 0U != u8x8_hw_spi_3w_is_busy();
+        }
+        if constexpr (IO_TYPE == INTERFACE::SPI_HW_IT)
+        {
+            return 0U != u8x8_hw_spi_it_is_busy();
+        }
+        if constexpr (IO_TYPE == INTERFACE::I2C_HW)
+        {
+            return 0U != u8x8_hw_i2c_is_busy();
+        }
+        return false;
+    }
+    void waitForTransfer()
+    {
+        if constexpr (EPAPER)
+        {
+            u8g2_epaper_wait();  // sleeps through the refresh
+        }
+        while(isBusy()) {}
+    }
+
+    static u8x8_stats_t getTransportStats()
+    {
+        u8x8_stats_t stats;
+        u8x8_stats_get(&stats);
+        return stats;
+    }
+    static void resetTransportStats() { u8x8_stats_reset(); }
+    const FrameStats& getFrameStats() const { return frameStats; }
+
+    // per-display CS/DC/RESET for displays sharing a bus, pins from U8X8_GPIO_PIN
+    void setBusPins(const uint8_t cs, const uint8_t dc, const uint8_t reset = U8X8_PIN_NONE)
+    {
+        auto *u8x8 = u8g2_GetU8x8(&u8g2);
+        u8x8_SetPin(u8x8, U8X8_PIN_CS, cs);
+        u8x8_SetPin(u8x8, U8X8_PIN_DC, dc);
+        u8x8_SetPin(u8x8, U8X8_PIN_RESET, reset);
+    }
+
     uint8_t *getBufferPtr() { return u8g2_GetBufferPtr(&u8g2); }
     uint_fast8_t getBufferTileHeight() { return u8g2_GetBufferTileHeight(&u8g2); }
     uint_fast8_t getBufferTileWidth() { return u8g2_GetBufferTileWidth(&u8g2); }
@@ -198,8 +625,8 @@ public:
         return strPixelLen;
     }
 
-    void sleepOn() { u8g2_SetPowerSave(&u8g2, 1U); }
-    void sleepOff() { u8g2_SetPowerSave(&u8g2, 0U); }
+    void sleepOn() { setPowerSave(1U); }
+    void sleepOff() { setPowerSave(0U); }
     void setColorIndex(uint8_t color_index) { u8g2_SetDrawColor(&u8g2, color_index); }
     uint_fast8_t getColorIndex() { return u8g2_GetDrawColor(&u8g2); }
     int_fast8_t getFontAscent() { return u8g2_GetAscent(&u8g2); }
@@ -285,7 +712,276 @@ protected:
 
 private:
     U8G2() = default;
+
+    enum class Boot : uint8_t { IDLE, PULSE_HIGH, PULSE_LOW, SETTLE, SENDING, READY };
+
+    void bootEnter(const Boot state)
+    {
+        boot = state;
+        bootAt = HAL_GetTick();
+        if(state == Boot::READY && bootDone != nullptr)
+        {
+            bootDone();
+        }
+    }
+
+    void bootRecord()
+    {
+        auto *u8x8 = u8g2_GetU8x8(&u8g2);
+        u8x8->gpio_and_delay_cb = bootGpio;
+        u8x8_hw_spi_dma_frame_begin();
+        u8g2_InitDisplay(&u8g2);
+        if constexpr (MEMLCD)
+        {
+            u8g2_ClearDisplay(&u8g2);
+        }
+        else
+        {
+            u8x8_hw_spi_dma_fill_begin(0U);
+            u8x8_ClearDisplay(u8x8);
+            u8x8_hw_spi_dma_fill_end();
+        }
+        u8g2_SetPowerSave(&u8g2, 0U);
+        bootTicket = u8x8_hw_spi_dma_frame_end();
+        u8x8->gpio_and_delay_cb = IO::gpio_cb;
+        contrast = flipMode = UNKNOWN;
+        powerSave = 0U;
+        forgetRam();
+        startLine = 0U;
+        hScroll = false;
+    }
+
+    /*
+     * GPIO callback while the init sequence is recorded. The reset pulse
+     * already happened in pollBegin(), so reset edges and the delay after
+     * each of them are dropped. A delay inside the sequence itself has to
+     * separate the bytes on the wire: the part recorded so far is sent and
+     * waited for, then recording goes on.
+     */
+    static uint8_t bootGpio(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+    {
+        switch(msg)
+        {
+            case U8X8_MSG_GPIO_RESET:
+                bootAfterReset = true;
+                return 1U;
+            case U8X8_MSG_DELAY_MILLI:
+                if(bootAfterReset)
+                {
+                    bootAfterReset = false;
+                    return 1U;
+                }
+                if(arg_int > 0U)
+                {
+                    u8x8_hw_spi_dma_wait_ticket(u8x8_hw_spi_dma_frame_end());
+                    IO::gpio_cb(u8x8, msg, arg_int, arg_ptr);
+                    u8x8_hw_spi_dma_frame_begin();
+                    return 1U;
+                }
+                break;
+            default:
+                break;
+        }
+        return IO::gpio_cb(u8x8, msg, arg_int, arg_ptr);
+    }
+
+    void sendCommands(std::initializer_list<uint8_t> cmds)
+    {
+        auto *u8x8 = u8g2_GetU8x8(&u8g2);
+        u8x8_cad_StartTransfer(u8x8);
+        for(const auto c : cmds)
+        {
+            u8x8_cad_SendCmd(u8x8, c);
+        }
+        u8x8_cad_EndTransfer(u8x8);
+    }
+
+    // count tile rows of the buffer from row on, wrapping at the bottom
+    void sendTileRows(uint8_t row, uint8_t count)
+    {
+        static_assert(M == MODE::FULL_BUFFER, "needs the whole frame in the buffer");
+        auto *u8x8 = u8g2_GetU8x8(&u8g2);
+        const uint8_t cols = u8x8->display_info->tile_width;
+        const uint8_t rows = u8x8->display_info->tile_height;
+        if constexpr (IO_TYPE == INTERFACE::SPI_HW_DMA)
+        {
+            recordBegin();
+        }
+        while(count-- > 0U)
+        {
+            row %= rows;
+            u8x8_DrawTile(u8x8, 0U, row, cols, u8g2.tile_buf_ptr + row * cols * 8U);
+            row++;
+        }
+        if constexpr (IO_TYPE == INTERFACE::SPI_HW_DMA)
+        {
+            recordEnd();
+        }
+    }
+
+    // a frame larger than the recording buffer is sent from the buffer itself,
+    // recordEnd() then returns once it is out
+    void recordBegin()
+    {
+        u8x8_hw_spi_dma_frame_begin();
+        u8x8_hw_spi_dma_lend(u8g2.tile_buf_ptr,
+            u8g2_GetBufferTileWidth(&u8g2) * 8U * u8g2_GetBufferTileHeight(&u8g2));
+    }
+
+    void recordEnd()
+    {
+        u8x8_hw_spi_dma_frame_end();
+        u8x8_hw_spi_dma_lend(nullptr, 0U);
+    }
+
+    void sendFrame()
+    {
+        if constexpr (MEMLCD)
+        {
+            u8g2_memlcd_send(&u8g2);
+        }
+        else if constexpr (EPAPER)
+        {
+            u8g2_epaper_send(&u8g2);
+        }
+        else if constexpr (M == MODE::DIFF_BUFFER)
+        {
+            u8g2_diff_send(&u8g2);
+        }
+        else
+        {
+            u8g2_SendBuffer(&u8g2);
+            if constexpr (DIRTY)
+            {
+                u8g2_dirty_reset(&u8g2);
+            }
+        }
+    }
+
+    void frameStart()
+    {
+        u8x8_stats_get(&frameBase);
+        framePages = 0U;
+        frameCycles = u8x8_cycles();
+    }
+
+    void frameEnd()
+    {
+        u8x8_stats_t now;
+        u8x8_stats_get(&now);
+        frameStats.bus.bytes = now.bytes - frameBase.bytes;
+        frameStats.bus.transfers = now.transfers - frameBase.transfers;
+        frameStats.bus.dc_toggles = now.dc_toggles - frameBase.dc_toggles;
+        frameStats.bus.block_cycles = now.block_cycles - frameBase.block_cycles;
+        frameStats.bus.timeouts = now.timeouts - frameBase.timeouts;
+        frameStats.bus.errors = now.errors - frameBase.errors;
+        frameStats.bus.elided = now.elided - frameBase.elided;
+        frameStats.pages = framePages > 0U ? framePages : 1U;
+        frameStats.cycles = u8x8_cycles() - frameCycles;
+    }
+
+    void setupPipelinedPages()
+    {
+        pageBuf[0] = u8g2.tile_buf_ptr;
+        pageBuf[1] = pageBuf[0] + u8g2_GetBufferTileWidth(&u8g2) * 8U;
+        u8g2_SetupBuffer(&u8g2, pageBuf[0], 1U, u8g2.ll_hvline, u8g2.cb);
+    }
+
+    uint8_t nextPipelinedPage()
+    {
+        auto *u8x8 = u8g2_GetU8x8(&u8g2);
+        const uint8_t w = u8g2_GetBufferTileWidth(&u8g2);
+        const uint8_t row = u8g2_GetBufferCurrTileRow(&u8g2);
+
+        u8x8_hw_spi_dma_lend(u8g2.tile_buf_ptr, w * 8U);
+        u8x8_DrawTile(u8x8, 0U, row, w, u8g2.tile_buf_ptr);
+        u8x8_hw_spi_dma_lend(nullptr, 0U);
+        pageTicket[page] = u8x8_hw_spi_dma_ticket();
+
+        // the other half was queued for the previous page, wait until it is out
+        page ^= 1U;
+        u8x8_hw_spi_dma_wait_ticket(pageTicket[page]);
+        u8g2.tile_buf_ptr = pageBuf[page];
+        if(row + 1U >= u8x8_GetRows(u8x8))
+        {
+            u8x8_RefreshDisplay(u8x8);
+            return 0U;
+        }
+        if(u8g2.is_auto_page_clear)
+        {
+            u8g2_ClearBuffer(&u8g2);
+        }
+        u8g2_SetBufferCurrTileRow(&u8g2, row + 1U);
+        return 1U;
+    }
+
+    // controller RAM changed behind the page signatures or the diff copy
+    void forgetRam()
+    {
+        pageSigValid = 0U;
+        if constexpr (M == MODE::DIFF_BUFFER)
+        {
+            u8g2_diff_invalidate(&u8g2);
+        }
+    }
+
+    /*
+     * Only pages whose CRC differs from the one sent last time go out.
+     * Anything that changes controller RAM behind nextPage()'s back
+     * (init, clear, flip, scroll) calls forgetRam().
+     */
+    uint8_t nextSignedPage()
+    {
+        auto *u8x8 = u8g2_GetU8x8(&u8g2);
+        const uint8_t w = u8g2_GetBufferTileWidth(&u8g2);
+        const uint8_t row = u8g2_GetBufferCurrTileRow(&u8g2);
+        // rows past pageSig are always sent and have no bit in pageSigValid
+        const bool tracked = row < pageSig.size();
+        const uint32_t bit = tracked ? (1UL << row) : 0UL;
+        const uint32_t sig = tracked ? u8x8_crc32(u8g2.tile_buf_ptr, w * 8U) : 0UL;
+
+        if(!tracked || (pageSigValid & bit) == 0U || pageSig[row] != sig)
+        {
+            u8x8_DrawTile(u8x8, 0U, row, w, u8g2.tile_buf_ptr);
+            if(tracked)
+            {
+                pageSig[row] = sig;
+                pageSigValid |= bit;
+            }
+        }
+        if(row + 1U >= u8x8_GetRows(u8x8))
+        {
+            u8x8_RefreshDisplay(u8x8);
+            return 0U;
+        }
+        if(u8g2.is_auto_page_clear)
+        {
+            u8g2_ClearBuffer(&u8g2);
+        }
+        u8g2_SetBufferCurrTileRow(&u8g2, row + 1U);
+        return 1U;
+    }
+
     u8g2_t u8g2;
+    uint8_t *pageBuf[2] = { nullptr, nullptr };
+    uint_fast8_t page = 0U;
+    uint32_t pageTicket[2] = { 0U, 0U };
+    Boot boot = Boot::IDLE;
+    uint32_t bootAt = 0U;
+    uint32_t bootTicket = 0U;
+    void (*bootDone)() = nullptr;
+    static inline bool bootAfterReset = false;
+    static constexpr uint16_t UNKNOWN = 0x100U;
+    uint16_t contrast = UNKNOWN, powerSave = UNKNOWN, flipMode = UNKNOWN;
+    uint8_t startLine = 0U;
+    bool hScroll = false;
+    uint8_t hScrollPages[2] = { 0U, 0U };
+    std::array<uint32_t, M == MODE::SIGNED_PAGE ? 16U : 0U> pageSig = {};
+    uint32_t pageSigValid = 0U;
+    u8x8_stats_t frameBase = {};
+    FrameStats frameStats = {};
+    uint32_t framePages = 0U;
+    uint32_t frameCycles = 0U;
     Coord_t rTx = 0U, rTy = 0U;
     Coord_t tx = 0U, ty = 0U;
 };
@@ -0,0 +1,319 @@
+/*
+ * stm32l4xx_hal.c
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: Władysław Ostrowski
+ */
+
+/*
+ This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#define _GNU_SOURCE
+#include "stm32l4xx_hal.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+uint32_t SystemCoreClock = 8000000U;
+
+mock_t mock;
+static DWT_Type mock_dwt;
+
+static SPI_TypeDef spi1_regs;
+static DMA_Channel_TypeDef dma1_ch3_regs;
+DMA_HandleTypeDef hdma_spi1_tx = { &dma1_ch3_regs, { 0U, 0U } };
+SPI_HandleTypeDef hspi1 = { &spi1_regs, { SPI_DATASIZE_8BIT, 0U }, &hdma_spi1_tx };
+I2C_HandleTypeDef hi2c1;
+TIM_HandleTypeDef htim1;
+UART_HandleTypeDef huart1 = { (void *)0x40013800UL };
+UART_HandleTypeDef huart2 = { (void *)0x40004400UL };
+
+static pthread_mutex_t irq_lock;
+static pthread_t isr_thread;
+static volatile uint8_t isr_run = 0U;
+static uint8_t isr_started = 0U;
+
+// GPIO ports live at their real addresses so GPIOA_BASE can be a template argument
+__attribute__((constructor)) static void mock_init(void)
+{
+  pthread_mutexattr_t attr;
+  void *ports = mmap((void *)GPIOA_BASE, 0x1000U, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+  if (ports != (void *)GPIOA_BASE)
+  {
+    fprintf(stderr, "mock: cannot map the GPIO ports at 0x%08lx\n", GPIOA_BASE);
+    exit(2);
+  }
+  pthread_mutexattr_init(&attr);
+  pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+  pthread_mutex_init(&irq_lock, &attr);
+  mock_reset();
+}
+
+void mock_reset(void)
+{
+  mock_run(0U);
+  mock_irq_disable();
+  memset(&mock, 0, sizeof(mock));
+  memset((void *)GPIOA_BASE, 0, 0x1000U);
+  dma1_ch3_regs.CCR = DMA_CCR_MINC;  // as MX_DMA_Init leaves it
+  spi1_regs.SR = SPI_SR_TXE;
+  hspi1.Init.DataSize = SPI_DATASIZE_8BIT;
+  huart1.Instance = (void *)0x40013800UL;
+  huart2.Instance = (void *)0x40004400UL;
+  mock_irq_enable();
+}
+
+// PRIMASK of the calling thread: one bit, as on the core, not a nesting count
+static __thread uint32_t primask = 0U;
+
+void mock_irq_disable(void)
+{
+  if (!primask)
+    pthread_mutex_lock(&irq_lock);
+  primask = 1U;
+}
+
+void mock_irq_enable(void)
+{
+  if (primask)
+    pthread_mutex_unlock(&irq_lock);
+  primask = 0U;
+}
+
+uint32_t mock_get_primask(void)
+{
+  return primask;
+}
+
+void mock_set_primask(uint32_t mask)
+{
+  if (mask & 1U)
+    mock_irq_disable();
+  else
+    mock_irq_enable();
+}
+
+// SysTick is the only thing that wakes the core in the tests
+void mock_wfi(void)
+{
+  mock.tick++;
+  if (mock.wfi != NULL)
+    mock.wfi();
+}
+
+DWT_Type *mock_dwt_access(void)
+{
+  mock_dwt.CYCCNT++;
+  if (mock.dwt != NULL)
+    mock.dwt();
+  return &mock_dwt;
+}
+
+uint32_t HAL_GetTick(void)
+{
+  return mock.tick;
+}
+
+uint32_t HAL_RCC_GetPCLK2Freq(void)
+{
+  return mock.pclk2 != 0U ? mock.pclk2 : SystemCoreClock;
+}
+
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init)
+{
+  (void)GPIOx;
+  (void)GPIO_Init;
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState)
+{
+  if (PinState != GPIO_PIN_RESET)
+    GPIOx->ODR |= GPIO_Pin;
+  else
+    GPIOx->ODR &= ~(uint32_t)GPIO_Pin;
+}
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+  return (GPIOx->IDR & GPIO_Pin) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+__weak void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
+{
+  (void)GPIO_Pin;
+}
+
+HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef *hdma)
+{
+  (void)hdma;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SPI_Init(SPI_HandleTypeDef *hspi)
+{
+  (void)hspi;
+  return HAL_OK;
+}
+
+// the blocking transport clears OVR once the last bit of a run is out
+void mock_spi_drained(SPI_HandleTypeDef *hspi)
+{
+  (void)hspi->Instance->DR;
+  mock.spi_drains++;
+}
+
+static void wire_log(uint8_t byte, uint8_t dc)
+{
+  if (mock.wire_len == MOCK_WIRE_SIZE)
+    return;
+  mock.wire[mock.wire_len].byte = byte;
+  mock.wire[mock.wire_len].dc = dc;
+  mock.wire[mock.wire_len].cs = mock.cs;
+  mock.wire_len++;
+}
+
+HAL_StatusTypeDef HAL_SPI_Transmit_DMA(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size)
+{
+  DMA_Channel_TypeDef *ch = hspi->hdmatx->Instance;
+  const uint8_t minc = (ch->CCR & DMA_CCR_MINC) != 0U;
+
+  if (mock.spi_busy)
+    return HAL_BUSY;
+  for (uint16_t i = 0U; i < Size; i++)
+  {
+    const uint16_t n = minc ? i : 0U;
+    if (hspi->Init.DataSize == SPI_DATASIZE_9BIT)
+    {
+      // 3-wire frames, DC is bit 8
+      const uint16_t frame = ((const uint16_t *)pData)[n];
+      wire_log((uint8_t)frame, (uint8_t)(frame >> 8));
+    }
+    else
+    {
+      wire_log(pData[n], mock.dc);
+    }
+  }
+  ch->CCR |= DMA_CCR_EN;
+  mock.spi_dma_starts++;
+  mock.spi_busy = 1U;
+  return HAL_OK;
+}
+
+__weak void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+  (void)hspi;
+}
+
+__weak void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi)
+{
+  (void)hspi;
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_DMA(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size)
+{
+  (void)hi2c;
+  if (mock.i2c_busy)
+    return HAL_BUSY;
+  if (mock.i2c_len < MOCK_I2C_WRITES)
+  {
+    mock_i2c_t *w = &mock.i2c[mock.i2c_len++];
+    w->addr = (uint8_t)DevAddress;
+    w->len = Size;
+    memcpy(w->data, pData, (Size < sizeof(w->data)) ? Size : sizeof(w->data));
+  }
+  mock.i2c_busy = 1U;
+  return HAL_OK;
+}
+
+__weak void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+  (void)hi2c;
+}
+
+__weak void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+  (void)hi2c;
+}
+
+HAL_StatusTypeDef HAL_TIMEx_PWMN_Start(TIM_HandleTypeDef *htim, uint32_t Channel)
+{
+  (void)htim;
+  (void)Channel;
+  mock.vcom_starts++;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_DeInit(UART_HandleTypeDef *huart)
+{
+  huart->Instance = NULL;
+  mock.uart_deinits++;
+  return HAL_OK;
+}
+
+// the transfer complete interrupt of SPI1 TX DMA
+uint8_t mock_spi_complete(void)
+{
+  uint8_t done = 0U;
+  mock_irq_disable();
+  if (mock.spi_busy)
+  {
+    mock.spi_busy = 0U;
+    hspi1.hdmatx->Instance->CCR &= ~DMA_CCR_EN;
+    HAL_SPI_TxCpltCallback(&hspi1);
+    done = 1U;
+  }
+  mock_irq_enable();
+  return done;
+}
+
+// the transfer complete interrupt of I2C1
+uint8_t mock_i2c_complete(void)
+{
+  uint8_t done = 0U;
+  mock_irq_disable();
+  if (mock.i2c_busy)
+  {
+    mock.i2c_busy = 0U;
+    HAL_I2C_MasterTxCpltCallback(&hi2c1);
+    done = 1U;
+  }
+  mock_irq_enable();
+  return done;
+}
+
+static void *mock_isr(void *arg)
+{
+  (void)arg;
+  for (;;)
+  {
+    if (!isr_run || !(mock_spi_complete() | mock_i2c_complete()))
+      sched_yield();
+  }
+  return NULL;
+}
+
+void mock_run(uint8_t on)
+{
+  if (on && !isr_started)
+  {
+    isr_started = 1U;
+    pthread_create(&isr_thread, NULL, mock_isr, NULL);
+  }
+  isr_run = on;
+}
@@ -0,0 +1,291 @@
+/*
+ * stm32l4xx_hal.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: Władysław Ostrowski
+ */
+
+/*
+ This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/*
+ * Host stand-in for the parts of the STM32L4 HAL that lib/u8g2/stm32 uses.
+ * Register blocks are plain memory: the GPIO ports sit at their real
+ * addresses (mapped by stm32l4xx_hal.c), so compile-time port templates
+ * work unchanged. DMA and I2C transfers are logged and complete either
+ * when the test says so or, after mock_run(1), from a second
+ * thread that plays the interrupt. __disable_irq() holds that thread off.
+ */
+
+#ifndef STM32L4XX_HAL_H
+#define STM32L4XX_HAL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define __IO volatile
+#define __weak __attribute__((weak))
+
+#define SET_BIT(REG, BIT) ((REG) |= (BIT))
+#define CLEAR_BIT(REG, BIT) ((REG) &= ~(BIT))
+
+typedef enum { HAL_OK = 0x00U, HAL_ERROR = 0x01U, HAL_BUSY = 0x02U, HAL_TIMEOUT = 0x03U } HAL_StatusTypeDef;
+
+extern uint32_t SystemCoreClock;
+
+void mock_irq_disable(void);
+void mock_irq_enable(void);
+uint32_t mock_get_primask(void);
+void mock_set_primask(uint32_t);
+void mock_wfi(void);
+#define __disable_irq() mock_irq_disable()
+#define __enable_irq() mock_irq_enable()
+#define __get_PRIMASK() mock_get_primask()
+#define __set_PRIMASK(mask) mock_set_primask(mask)
+#define __WFI() mock_wfi()
+#define __NOP() __asm__ volatile("nop")
+
+static inline uint32_t __RBIT(uint32_t v)
+{
+  uint32_t r = 0U;
+  for (uint8_t i = 0U; i < 32U; i++, v >>= 1)
+    r = (r << 1) | (v & 1U);
+  return r;
+}
+
+/*
+ * DWT, its counter advances by one on every access so busy waits on it end
+ * (u8g2_delay.c counts virtually on the host and does not touch it)
+ */
+typedef struct
+{
+  __IO uint32_t CTRL, CYCCNT;
+} DWT_Type;
+
+DWT_Type *mock_dwt_access(void);
+#define DWT (mock_dwt_access())
+
+uint32_t HAL_GetTick(void);
+uint32_t HAL_RCC_GetPCLK2Freq(void);
+
+/* GPIO */
+typedef struct
+{
+  __IO uint32_t MODER, OTYPER, OSPEEDR, PUPDR, IDR, ODR, BSRR, LCKR, AFR[2], BRR, ASCR;
+} GPIO_TypeDef;
+
+typedef struct
+{
+  uint32_t Pin, Mode, Pull, Speed, Alternate;
+} GPIO_InitTypeDef;
+
+typedef enum { GPIO_PIN_RESET = 0U, GPIO_PIN_SET } GPIO_PinState;
+
+#define GPIOA_BASE 0x48000000UL
+#define GPIOB_BASE 0x48000400UL
+#define GPIOC_BASE 0x48000800UL
+#define GPIOA ((GPIO_TypeDef *)GPIOA_BASE)
+#define GPIOB ((GPIO_TypeDef *)GPIOB_BASE)
+#define GPIOC ((GPIO_TypeDef *)GPIOC_BASE)
+
+#define GPIO_PIN_0 ((uint16_t)0x0001)
+#define GPIO_PIN_1 ((uint16_t)0x0002)
+#define GPIO_PIN_2 ((uint16_t)0x0004)
+#define GPIO_PIN_3 ((uint16_t)0x0008)
+#define GPIO_PIN_4 ((uint16_t)0x0010)
+#define GPIO_PIN_5 ((uint16_t)0x0020)
+#define GPIO_PIN_6 ((uint16_t)0x0040)
+#define GPIO_PIN_7 ((uint16_t)0x0080)
+#define GPIO_PIN_8 ((uint16_t)0x0100)
+#define GPIO_PIN_9 ((uint16_t)0x0200)
+#define GPIO_PIN_10 ((uint16_t)0x0400)
+#define GPIO_PIN_11 ((uint16_t)0x0800)
+#define GPIO_PIN_12 ((uint16_t)0x1000)
+#define GPIO_PIN_13 ((uint16_t)0x2000)
+#define GPIO_PIN_14 ((uint16_t)0x4000)
+#define GPIO_PIN_15 ((uint16_t)0x8000)
+
+#define GPIO_MODE_INPUT 0x0U
+#define GPIO_MODE_OUTPUT_PP 0x1U
+#define GPIO_MODE_OUTPUT_OD 0x11U
+#define GPIO_NOPULL 0x0U
+#define GPIO_PULLUP 0x1U
+#define GPIO_PULLDOWN 0x2U
+#define GPIO_SPEED_FREQ_VERY_HIGH 0x3U
+
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init);
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin);
+
+/* DMA */
+typedef struct
+{
+  __IO uint32_t CCR, CNDTR, CPAR, CMAR;
+} DMA_Channel_TypeDef;
+
+#define DMA_CCR_EN 0x00000001U
+#define DMA_CCR_MINC 0x00000080U
+#define DMA_PDATAALIGN_HALFWORD 0x00000100U
+#define DMA_MDATAALIGN_HALFWORD 0x00000400U
+
+typedef struct
+{
+  uint32_t PeriphDataAlignment, MemDataAlignment;
+} DMA_InitTypeDef;
+
+typedef struct
+{
+  DMA_Channel_TypeDef *Instance;
+  DMA_InitTypeDef Init;
+} DMA_HandleTypeDef;
+
+HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef *hdma);
+
+/* SPI */
+typedef struct
+{
+  __IO uint32_t CR1, CR2, SR, DR, CRCPR, RXCRCR, TXCRCR;
+} SPI_TypeDef;
+
+#define SPI_CR1_BR_Pos 3U
+#define SPI_CR1_BR (0x7U << SPI_CR1_BR_Pos)
+#define SPI_CR1_SPE 0x00000040U
+#define SPI_CR2_RXNEIE 0x00000040U
+#define SPI_CR2_TXEIE 0x00000080U
+#define SPI_CR2_FRXTH 0x00001000U
+#define SPI_SR_RXNE 0x00000001U
+#define SPI_SR_TXE 0x00000002U
+#define SPI_SR_BSY 0x00000080U
+#define SPI_SR_FRLVL 0x00000600U
+#define SPI_SR_FTLVL 0x00001800U
+#define SPI_DATASIZE_8BIT 0x00000700U
+#define SPI_DATASIZE_9BIT 0x00000800U
+
+typedef struct
+{
+  uint32_t DataSize, BaudRatePrescaler;
+} SPI_InitTypeDef;
+
+typedef struct
+{
+  SPI_TypeDef *Instance;
+  SPI_InitTypeDef Init;
+  DMA_HandleTypeDef *hdmatx;
+} SPI_HandleTypeDef;
+
+#define __HAL_SPI_ENABLE(h) SET_BIT((h)->Instance->CR1, SPI_CR1_SPE)
+#define __HAL_SPI_CLEAR_OVRFLAG(h) mock_spi_drained(h)
+
+void mock_spi_drained(SPI_HandleTypeDef *hspi);
+HAL_StatusTypeDef HAL_SPI_Init(SPI_HandleTypeDef *hspi);
+HAL_StatusTypeDef HAL_SPI_Transmit_DMA(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size);
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi);
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi);
+
+/* I2C */
+typedef struct
+{
+  void *Instance;
+} I2C_HandleTypeDef;
+
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_DMA(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size);
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c);
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c);
+
+/* TIM */
+typedef struct
+{
+  void *Instance;
+} TIM_HandleTypeDef;
+
+#define TIM_CHANNEL_3 0x00000008U
+
+HAL_StatusTypeDef HAL_TIMEx_PWMN_Start(TIM_HandleTypeDef *htim, uint32_t Channel);
+
+/* UART, only torn down by the parallel bus */
+typedef struct
+{
+  void *Instance;
+} UART_HandleTypeDef;
+
+HAL_StatusTypeDef HAL_UART_DeInit(UART_HandleTypeDef *huart);
+
+/*
+ * Test side. Every byte that leaves through SPI DMA is logged with the DC
+ * level and the display whose CS was asserted, I2C writes are logged as a
+ * whole. CS and DC come from mock_gpio_and_delay (test.h).
+ */
+#define MOCK_WIRE_SIZE 16384U
+#define MOCK_I2C_WRITES 64U
+
+typedef struct
+{
+  uint8_t byte;
+  uint8_t dc;
+  const void *cs;  // u8x8 with CS asserted, NULL if none
+} mock_wire_t;
+
+typedef struct
+{
+  uint8_t addr;
+  uint16_t len;
+  uint8_t data[1100];
+} mock_i2c_t;
+
+typedef struct
+{
+  volatile uint8_t spi_busy;
+  volatile uint8_t i2c_busy;
+  uint32_t spi_dma_starts;
+  uint32_t spi_drains;  // blocking path waited for the bus to go idle
+  uint32_t wire_len;
+  mock_wire_t wire[MOCK_WIRE_SIZE];
+  uint32_t i2c_len;
+  mock_i2c_t i2c[MOCK_I2C_WRITES];
+  const void *cs;
+  uint8_t dc;
+  uint32_t cs_edges;
+  uint32_t delay_ns;
+  uint32_t tick;
+  uint32_t pclk2;     // HAL_RCC_GetPCLK2Freq(), SystemCoreClock while 0
+  void (*wfi)(void);  // called on every __WFI() after the tick advanced
+  void (*dwt)(void);  // called on every DWT access after the counter advanced
+  uint32_t vcom_starts;
+  uint32_t uart_deinits;
+} mock_t;
+
+extern mock_t mock;
+extern SPI_HandleTypeDef hspi1;
+extern DMA_HandleTypeDef hdma_spi1_tx;
+extern I2C_HandleTypeDef hi2c1;
+extern TIM_HandleTypeDef htim1;
+extern UART_HandleTypeDef huart1;
+extern UART_HandleTypeDef huart2;
+
+void mock_reset(void);
+uint8_t mock_spi_complete(void);
+uint8_t mock_i2c_complete(void);
+void mock_run(uint8_t on);  // let the interrupt thread complete transfers
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,65 @@
+/*
+ * test.c
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: Władysław Ostrowski
+ */
+
+/*
+ This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "test.h"
+
+int test_failures = 0;
+
+uint8_t mock_gpio_and_delay(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  (void)arg_ptr;
+  switch(msg)
+  {
+    case U8X8_MSG_GPIO_CS:
+      if (arg_int == u8x8->display_info->chip_enable_level)
+        mock.cs = u8x8;
+      else if (mock.cs == u8x8)
+        mock.cs = NULL;
+      mock.cs_edges++;
+      break;
+    case U8X8_MSG_GPIO_DC:
+      mock.dc = arg_int;
+      break;
+    case U8X8_MSG_DELAY_NANO:
+      mock.delay_ns += arg_int;
+      break;
+    default:
+      break;
+  }
+  return 1;
+}
+
+int wire_find(uint32_t from, uint8_t dc)
+{
+  for (uint32_t i = from; i < mock.wire_len; i++)
+  {
+    if (mock.wire[i].dc == dc)
+      return (int)i;
+  }
+  return -1;
+}
+
+int test_report(const char *name)
+{
+  printf("%s: %s\n", name, test_failures ? "FAILED" : "ok");
+  return test_failures ? 1 : 0;
+}
@@ -0,0 +1,58 @@
+/*
+ * test.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: Władysław Ostrowski
+ */
+
+/*
+ This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef TEST_H
+#define TEST_H
+
+#include "u8g2_io.h"
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern int test_failures;
+
+#define CHECK(cond) \
+  do { if (!(cond)) { test_failures++; \
+    fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); } } while (0)
+
+#define CHECK_EQ(a, b) \
+  do { const long long a_ = (long long)(a), b_ = (long long)(b); if (a_ != b_) { test_failures++; \
+    fprintf(stderr, "%s:%d: %s == %lld, expected %s == %lld\n", __FILE__, __LINE__, #a, a_, #b, b_); } } while (0)
+
+#define RUN(test) \
+  do { mock_reset(); u8x8_stats_reset(); test(); } while (0)
+
+// gpio_and_delay_cb that tells the mock which display has CS and the DC level
+uint8_t mock_gpio_and_delay(u8x8_t*, uint8_t, uint8_t, void*);
+
+// wire bytes from index from on with the given DC level, -1 if none
+int wire_find(uint32_t from, uint8_t dc);
+
+int test_report(const char*);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,42 @@
+/*
+ * test_crc.c
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: Władysław Ostrowski
+ */
+
+/*
+ This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "test.h"
+
+/*
+ * Software CRC-32 of the host build against the CRC peripheral settings
+ * (CRC-32/MPEG-2): its check value and the untouched init value.
+ */
+
+static void test_check_value(void)
+{
+  const uint8_t check[] = "123456789";
+  CHECK_EQ(u8x8_crc32(check, 9U), 0x0376E6E7UL);
+  CHECK_EQ(u8x8_crc32(check, 0U), 0xFFFFFFFFUL);
+}
+
+int main(void)
+{
+  RUN(test_check_value);
+  return test_report("crc");
+}
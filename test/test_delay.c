@@ -0,0 +1,66 @@
+/*
+ * test_delay.c
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: Władysław Ostrowski
+ */
+
+/*
+ This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "test.h"
+
+/*
+ * Cycle delays on the virtual counter of host builds: conversions round
+ * up and follow SystemCoreClock.
+ */
+
+static uint32_t cycles_of(void (*delay)(uint32_t), uint32_t arg)
+{
+  const uint32_t start = u8x8_cycles();
+  delay(arg);
+  return u8x8_cycles() - start - 1U;  // the second read costs one
+}
+
+static void test_conversions(void)
+{
+  SystemCoreClock = 8000000U;
+  CHECK_EQ(cycles_of(u8x8_delay_ns, 1U), 1);      // never shorter than asked
+  CHECK_EQ(cycles_of(u8x8_delay_ns, 125U), 1);
+  CHECK_EQ(cycles_of(u8x8_delay_ns, 126U), 2);
+  CHECK_EQ(cycles_of(u8x8_delay_us, 10U), 80);
+  CHECK_EQ(cycles_of(u8x8_delay_ms, 2U), 16000);
+
+  SystemCoreClock = 80000000U;
+  CHECK_EQ(cycles_of(u8x8_delay_ns, 100U), 8);
+  CHECK_EQ(cycles_of(u8x8_delay_ms, 1U), 80000);
+  SystemCoreClock = 8000000U;
+}
+
+// a byte callback's delay message goes the same way
+static void test_gpio_delay_msg(void)
+{
+  u8x8_t u8x8 = { 0 };
+  const uint32_t start = u8x8_cycles();
+  u8x8_gpio_and_delay(&u8x8, U8X8_MSG_DELAY_10MICRO, 3U, NULL);
+  CHECK_EQ(u8x8_cycles() - start - 1U, 240);
+}
+
+int main(void)
+{
+  RUN(test_conversions);
+  RUN(test_gpio_delay_msg);
+  return test_report("delay");
+}
@@ -0,0 +1,215 @@
+/*
+ * test_diff.c
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: Władysław Ostrowski
+ */
+
+/*
+ This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "test.h"
+
+/*
+ * Column runs (MODE::DIFF_BUFFER): the first send after attach or
+ * u8g2_diff_invalidate() is the whole frame, after that only the changed
+ * columns go out, each run addressed with column high, column low and
+ * page. Changes less than DIFF_MERGE_GAP (4) columns apart share a run.
+ */
+
+static u8g2_t u8g2;
+static uint32_t len;
+static uint32_t transfers;
+static struct
+{
+  uint8_t dc;
+  uint8_t byte;
+} sent[8U * (3U + 128U)];
+
+static uint8_t log_bytes(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  static uint8_t dc;
+  const uint8_t *data = (const uint8_t *)arg_ptr;
+  (void)u8x8;
+  if (msg == U8X8_MSG_BYTE_START_TRANSFER)
+    transfers++;
+  else if (msg == U8X8_MSG_BYTE_SET_DC)
+    dc = arg_int;
+  else if (msg == U8X8_MSG_BYTE_SEND)
+  {
+    for (uint8_t i = 0U; i < arg_int && len < sizeof(sent) / sizeof(sent[0]); i++, len++)
+    {
+      sent[len].dc = dc;
+      sent[len].byte = data[i];
+    }
+  }
+  return 1U;
+}
+
+static void clear_log(void)
+{
+  len = 0U;
+  transfers = 0U;
+}
+
+static void attach(void (*chip)(u8g2_t*, const u8g2_cb_t*, u8x8_msg_cb, u8x8_msg_cb))
+{
+  chip(&u8g2, U8G2_R0, log_bytes, mock_gpio_and_delay);
+  u8g2_diff_attach(&u8g2);
+  for (uint16_t n = 0U; n < 8U * 128U; n++)
+    u8g2.tile_buf_ptr[n] = (uint8_t)(n * 7U);
+  clear_log();
+}
+
+// sent once, so the RAM copy holds the buffer
+static void setup(void (*chip)(u8g2_t*, const u8g2_cb_t*, u8x8_msg_cb, u8x8_msg_cb))
+{
+  attach(chip);
+  u8g2_diff_send(&u8g2);
+  clear_log();
+}
+
+static uint8_t *column(const uint8_t page, const uint16_t col)
+{
+  return &u8g2.tile_buf_ptr[page * 128U + col];
+}
+
+// the run at sent[at]: its addressing and n bytes of the buffer, returns the next
+static uint32_t check_run(const uint32_t at, const uint8_t page, const uint16_t col, const uint16_t n)
+{
+  const uint16_t x = col + u8g2_GetU8x8(&u8g2)->x_offset;
+  const uint8_t *data = column(page, col);
+
+  CHECK(at + 3U + n <= len);
+  if (at + 3U + n > len)
+    return len;
+  CHECK_EQ(sent[at].dc, 0);
+  CHECK_EQ(sent[at].byte, 0x10 | (x >> 4));
+  CHECK_EQ(sent[at + 1U].dc, 0);
+  CHECK_EQ(sent[at + 1U].byte, x & 0x0F);
+  CHECK_EQ(sent[at + 2U].dc, 0);
+  CHECK_EQ(sent[at + 2U].byte, 0xB0 | page);
+  for (uint16_t i = 0U; i < n; i++)
+  {
+    CHECK_EQ(sent[at + 3U + i].dc, 1);
+    CHECK_EQ(sent[at + 3U + i].byte, data[i]);
+  }
+  return at + 3U + n;
+}
+
+static void test_first_send_is_the_frame(void)
+{
+  uint32_t at = 0U;
+
+  attach(u8g2_Setup_ssd1306_128x64_noname_f);
+  u8g2_diff_send(&u8g2);
+  for (uint8_t page = 0U; page < 8U; page++)
+    at = check_run(at, page, 0U, 128U);
+  CHECK_EQ(len, at);
+  CHECK_EQ(transfers, 8);
+
+  clear_log();
+  u8g2_diff_send(&u8g2);
+  CHECK_EQ(len, 0);
+  CHECK_EQ(transfers, 0);
+}
+
+static void test_runs_merge_within_the_gap(void)
+{
+  uint32_t at = 0U;
+
+  setup(u8g2_Setup_ssd1306_128x64_noname_f);
+  // three equal columns between: one run over them
+  *column(2U, 10U) ^= 0xFFU;
+  *column(2U, 14U) ^= 0xFFU;
+  // four equal columns between: two runs
+  *column(2U, 40U) ^= 0xFFU;
+  *column(2U, 45U) ^= 0xFFU;
+  u8g2_diff_send(&u8g2);
+  at = check_run(at, 2U, 10U, 5U);
+  at = check_run(at, 2U, 40U, 1U);
+  at = check_run(at, 2U, 45U, 1U);
+  CHECK_EQ(len, at);
+  // all runs of a page in one transfer
+  CHECK_EQ(transfers, 1);
+
+  clear_log();
+  u8g2_diff_send(&u8g2);
+  CHECK_EQ(len, 0);
+}
+
+// SH1106: 128 of its 132 columns are shown, from column 2 on
+static void test_x_offset(void)
+{
+  uint32_t at = 0U;
+
+  setup(u8g2_Setup_sh1106_128x64_noname_f);
+  CHECK_EQ(u8g2_GetU8x8(&u8g2)->x_offset, 2);
+  *column(0U, 0U) ^= 0xFFU;
+  *column(0U, 126U) ^= 0xFFU;
+  u8g2_diff_send(&u8g2);
+  CHECK_EQ(sent[0].byte, 0x10);
+  CHECK_EQ(sent[1].byte, 0x02);
+  at = check_run(at, 0U, 0U, 1U);
+  CHECK_EQ(sent[at].byte, 0x18);
+  CHECK_EQ(sent[at + 1U].byte, 0x00);
+  at = check_run(at, 0U, 126U, 1U);
+  CHECK_EQ(len, at);
+}
+
+static void test_run_to_the_last_column(void)
+{
+  uint32_t at = 0U;
+
+  setup(u8g2_Setup_ssd1306_128x64_noname_f);
+  // found by the byte loop after the word loop stopped at 124
+  *column(6U, 127U) ^= 0xFFU;
+  // the merge scan ends at the panel edge
+  *column(7U, 125U) ^= 0xFFU;
+  *column(7U, 127U) ^= 0xFFU;
+  u8g2_diff_send(&u8g2);
+  at = check_run(at, 6U, 127U, 1U);
+  at = check_run(at, 7U, 125U, 3U);
+  CHECK_EQ(len, at);
+  CHECK_EQ(transfers, 2);
+}
+
+// what U8G2::forgetRam() calls after init, clear, flip or scroll
+static void test_invalidate(void)
+{
+  uint32_t at = 0U;
+
+  setup(u8g2_Setup_ssd1306_128x64_noname_f);
+  u8g2_diff_invalidate(&u8g2);
+  u8g2_diff_send(&u8g2);
+  for (uint8_t page = 0U; page < 8U; page++)
+    at = check_run(at, page, 0U, 128U);
+  CHECK_EQ(len, at);
+
+  clear_log();
+  u8g2_diff_send(&u8g2);
+  CHECK_EQ(len, 0);
+}
+
+int main(void)
+{
+  RUN(test_first_send_is_the_frame);
+  RUN(test_runs_merge_within_the_gap);
+  RUN(test_x_offset);
+  RUN(test_run_to_the_last_column);
+  RUN(test_invalidate);
+  return test_report("diff");
+}
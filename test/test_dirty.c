@@ -0,0 +1,123 @@
+/*
+ * test_dirty.c
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: Władysław Ostrowski
+ */
+
+/*
+ This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "test.h"
+
+/*
+ * Dirty rectangle: not hooked until the first u8g2_dirty_send(), which
+ * sends the whole buffer; with every slot taken it keeps doing that.
+ */
+
+static u8g2_t u8g2;
+static u8g2_t others[U8X8_DIRTY_SLOTS];
+static uint32_t rows;
+
+static uint8_t count_rows(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  (void)u8x8;
+  (void)arg_int;
+  (void)arg_ptr;
+  if (msg == U8X8_MSG_BYTE_START_TRANSFER)
+    rows++;
+  return 1U;
+}
+
+static void setup(u8g2_t *u)
+{
+  u8g2_Setup_ssd1306_128x64_noname_f(u, U8G2_R0, count_rows, mock_gpio_and_delay);
+}
+
+static void test_attach_on_first_send(void)
+{
+  u8g2_draw_ll_hvline_cb plain;
+
+  setup(&u8g2);
+  plain = u8g2.ll_hvline;
+  u8g2_dirty_mark_all(&u8g2);
+  CHECK(u8g2.ll_hvline == plain);
+
+  rows = 0U;
+  u8g2_dirty_send(&u8g2);
+  CHECK_EQ(rows, 8);
+  CHECK(u8g2.ll_hvline != plain);
+
+  rows = 0U;
+  u8g2_DrawBox(&u8g2, 8, 20, 30, 4);  // tiles (1..4, 2)
+  u8g2_dirty_send(&u8g2);
+  CHECK_EQ(rows, 1);
+  rows = 0U;
+  u8g2_dirty_send(&u8g2);
+  CHECK_EQ(rows, 0);
+}
+
+// the rows of the bigger box go out again, blank now
+static void test_clear_sends_what_was_drawn(void)
+{
+  setup(&u8g2);
+  u8g2_dirty_send(&u8g2);  // attached again, all of it counts as drawn
+  u8g2_dirty_clear(&u8g2);
+  u8g2_dirty_send(&u8g2);
+
+  rows = 0U;
+  u8g2_DrawBox(&u8g2, 0, 8, 64, 24);  // tile rows 1..3
+  u8g2_dirty_send(&u8g2);
+  CHECK_EQ(rows, 3);
+
+  rows = 0U;
+  u8g2_dirty_clear(&u8g2);
+  u8g2_DrawBox(&u8g2, 16, 16, 8, 4);  // tile row 2
+  u8g2_dirty_send(&u8g2);
+  CHECK_EQ(rows, 3);
+
+  // only the small box was drawn since that clear
+  rows = 0U;
+  u8g2_dirty_clear(&u8g2);
+  u8g2_DrawBox(&u8g2, 16, 16, 8, 4);
+  u8g2_dirty_send(&u8g2);
+  CHECK_EQ(rows, 1);
+}
+
+static void test_out_of_slots(void)
+{
+  // the slots are static: u8g2 from above holds one already
+  for (uint8_t i = 0U; i + 1U < U8X8_DIRTY_SLOTS; i++)
+  {
+    setup(&others[i]);
+    u8g2_dirty_send(&others[i]);
+  }
+  setup(&others[U8X8_DIRTY_SLOTS - 1U]);
+  rows = 0U;
+  u8g2_dirty_send(&others[U8X8_DIRTY_SLOTS - 1U]);
+  CHECK_EQ(rows, 8);
+  rows = 0U;
+  u8g2_dirty_send(&others[U8X8_DIRTY_SLOTS - 1U]);
+  CHECK_EQ(rows, 8);
+}
+
+int main(void)
+{
+  RUN(test_attach_on_first_send);
+  RUN(test_clear_sends_what_was_drawn);
+  RUN(test_out_of_slots);
+  return test_report("dirty");
+}
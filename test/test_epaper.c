@@ -0,0 +1,161 @@
+/*
+ * test_epaper.c
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: Władysław Ostrowski
+ */
+
+/*
+ This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "test.h"
+
+/*
+ * E-paper window sends and the BUSY state machine. The panel is an IL3820
+ * (37x16 tiles); BUSY on PB0 is driven through GPIOB->IDR and its edges
+ * are delivered by calling u8g2_epaper_busy_isr() as EXTI0_IRQHandler does.
+ */
+
+static u8g2_t u8g2;
+static u8x8_msg_cb display_cb;
+static struct { uint8_t rows, x0, y0, x1, y1; } sent;
+
+static uint8_t log_tiles(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  if (msg == U8X8_MSG_DISPLAY_DRAW_TILE)
+  {
+    const u8x8_tile_t *t = arg_ptr;
+    const uint8_t x1 = (uint8_t)(t->x_pos + t->cnt - 1U);
+    if (sent.rows == 0U || t->x_pos < sent.x0) sent.x0 = t->x_pos;
+    if (sent.rows == 0U || t->y_pos < sent.y0) sent.y0 = t->y_pos;
+    if (sent.rows == 0U || x1 > sent.x1) sent.x1 = x1;
+    if (sent.rows == 0U || t->y_pos > sent.y1) sent.y1 = t->y_pos;
+    sent.rows++;
+  }
+  return display_cb(u8x8, msg, arg_int, arg_ptr);
+}
+
+static void busy(uint8_t level)
+{
+  if (level)
+    GPIOB->IDR |= BUSY_Pin;
+  else
+    GPIOB->IDR &= ~(uint32_t)BUSY_Pin;
+  u8g2_epaper_busy_isr();
+}
+
+static void send(void)
+{
+  sent.rows = 0U;
+  u8g2_epaper_send(&u8g2);
+}
+
+static void setup(void)
+{
+  u8g2_Setup_il3820_296x128_f(&u8g2, U8G2_R0, u8x8_byte_hw_spi, mock_gpio_and_delay);
+  display_cb = u8g2_GetU8x8(&u8g2)->display_cb;
+  u8g2_GetU8x8(&u8g2)->display_cb = log_tiles;
+  u8x8_hw_spi_init();
+  u8g2_ClearBuffer(&u8g2);
+  u8g2_epaper_attach(&u8g2, 1U);
+}
+
+static void test_window_and_previous(void)
+{
+  setup();
+  send();
+  // the first send after attach is a full refresh of the whole panel
+  CHECK_EQ(sent.rows, 16);
+  CHECK_EQ(sent.x0, 0);
+  CHECK_EQ(sent.x1, 36);
+  busy(1U);
+  busy(0U);
+
+  u8g2_DrawBox(&u8g2, 16, 16, 8, 8);  // tile (2, 2)
+  send();
+  // the other RAM image still holds the full refresh
+  CHECK_EQ(sent.rows, 16);
+  busy(1U);
+  busy(0U);
+
+  u8g2_DrawBox(&u8g2, 80, 64, 16, 8);  // tiles (10..11, 8)
+  send();
+  // this window and the previous one, (2, 2), to update the other image
+  CHECK_EQ(sent.x0, 2);
+  CHECK_EQ(sent.y0, 2);
+  CHECK_EQ(sent.x1, 11);
+  CHECK_EQ(sent.y1, 8);
+  CHECK_EQ(sent.rows, 7);
+  busy(1U);
+  busy(0U);
+
+  send();
+  // nothing drawn since, nothing sent
+  CHECK_EQ(sent.rows, 0);
+  CHECK_EQ(u8g2_epaper_is_busy(), 0);
+}
+
+static void test_busy_edges(void)
+{
+  setup();
+  send();
+  // ACTIVATING until BUSY rises
+  CHECK_EQ(u8g2_epaper_is_busy(), 1);
+  mock.tick += 10U;
+  busy(1U);
+  // REFRESHING past the activation timeout while BUSY stays high
+  mock.tick += 1000U;
+  CHECK_EQ(u8g2_epaper_is_busy(), 1);
+  busy(0U);
+  CHECK_EQ(u8g2_epaper_is_busy(), 0);
+  CHECK_EQ(u8x8_stats.timeouts, 0);
+
+  // polled from a critical section, interrupts stay off
+  __disable_irq();
+  CHECK_EQ(u8g2_epaper_is_busy(), 0);
+  CHECK_EQ(__get_PRIMASK(), 1);
+  __enable_irq();
+}
+
+static void test_activate_timeout(void)
+{
+  setup();
+  send();
+  // BUSY never rises: wait() gives up after EPD_ACTIVATE_MS
+  const uint32_t t0 = mock.tick;
+  u8g2_epaper_wait();
+  CHECK_EQ(mock.tick - t0, 100);
+  CHECK_EQ(u8g2_epaper_is_busy(), 0);
+
+  // the rising edge is missed: the refresh is picked up from the level
+  u8g2_DrawBox(&u8g2, 0, 0, 8, 8);
+  send();
+  GPIOB->IDR |= BUSY_Pin;
+  mock.tick += 100U;
+  CHECK_EQ(u8g2_epaper_is_busy(), 1);
+  mock.tick += 5000U;
+  CHECK_EQ(u8g2_epaper_is_busy(), 0);
+  CHECK_EQ(u8x8_stats.timeouts, 1);
+  GPIOB->IDR &= ~(uint32_t)BUSY_Pin;
+}
+
+int main(void)
+{
+  RUN(test_window_and_previous);
+  RUN(test_busy_edges);
+  RUN(test_activate_timeout);
+  return test_report("epaper");
+}
@@ -0,0 +1,109 @@
+/*
+ * test_i2c.c
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: Władysław Ostrowski
+ */
+
+/*
+ This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "test.h"
+#include <string.h>
+
+/*
+ * INTERFACE::I2C_HW: every START/END pair is one DMA write, and the data
+ * chunks u8x8_cad_ssd13xx_fast_i2c cuts a page into are merged into the
+ * queued write while the one before it is on the bus.
+ */
+
+static u8g2_t u8g2;
+
+static void setup(void)
+{
+  u8g2_Setup_ssd1306_i2c_128x64_noname_f(&u8g2, U8G2_R0, u8x8_byte_hw_i2c, mock_gpio_and_delay);
+}
+
+static void test_page_is_two_writes(void)
+{
+  u8x8_t *u8x8 = u8g2_GetU8x8(&u8g2);
+  uint8_t *row;
+
+  setup();
+  row = u8g2.tile_buf_ptr;
+  for (uint16_t n = 0U; n < 128U; n++)
+    row[n] = (uint8_t)(n ^ 0x5AU);
+  u8x8_DrawTile(u8x8, 0U, 3U, 16U, row);
+
+  // the command write is on the bus, the data chunks wait merged behind it
+  CHECK_EQ(mock.i2c_len, 1);
+  CHECK_EQ(mock.i2c[0].addr, u8x8_GetI2CAddress(u8x8));
+  CHECK_EQ(mock.i2c[0].data[0], 0x00);
+  CHECK(memchr(&mock.i2c[0].data[1], 0xB3, mock.i2c[0].len - 1U) != NULL);
+  CHECK(u8x8_hw_i2c_is_busy());
+
+  CHECK(mock_i2c_complete());
+  CHECK_EQ(mock.i2c_len, 2);
+  CHECK_EQ(mock.i2c[1].addr, u8x8_GetI2CAddress(u8x8));
+  CHECK_EQ(mock.i2c[1].len, 1 + 128);
+  CHECK_EQ(mock.i2c[1].data[0], 0x40);
+  CHECK(memcmp(&mock.i2c[1].data[1], row, 128U) == 0);
+
+  CHECK(mock_i2c_complete());
+  CHECK(!u8x8_hw_i2c_is_busy());
+  CHECK(!mock_i2c_complete());
+}
+
+static void test_frame(void)
+{
+  uint32_t data = 0U;
+  uint32_t cmds = 0U;
+
+  setup();
+  for (uint16_t n = 0U; n < 1024U; n++)
+    u8g2.tile_buf_ptr[n] = (uint8_t)(n * 7U);
+  mock_run(1U);
+  u8g2_SendBuffer(&u8g2);
+  u8x8_hw_i2c_wait();
+  mock_run(0U);
+
+  // however the writes were merged, the frame arrives in order and complete
+  for (uint32_t w = 0U; w < mock.i2c_len; w++)
+  {
+    const mock_i2c_t *m = &mock.i2c[w];
+    if (m->data[0] == 0x00U)
+    {
+      cmds++;
+      continue;
+    }
+    CHECK_EQ(m->data[0], 0x40);
+    CHECK(data + m->len - 1U <= 1024U);
+    CHECK(memcmp(&m->data[1], &u8g2.tile_buf_ptr[data], m->len - 1U) == 0);
+    data += m->len - 1U;
+  }
+  CHECK_EQ(cmds, 8);
+  CHECK_EQ(data, 1024);
+  // per page one command write and six data chunks, at most that many writes
+  CHECK_EQ(u8x8_stats.transfers, 8 * 7);
+  CHECK(mock.i2c_len >= 16U && mock.i2c_len <= 8U * 7U);
+  printf("frame: %u I2C writes for %u transfers\n", (unsigned)mock.i2c_len, (unsigned)u8x8_stats.transfers);
+}
+
+int main(void)
+{
+  RUN(test_page_is_two_writes);
+  RUN(test_frame);
+  return test_report("i2c");
+}
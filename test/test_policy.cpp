@@ -0,0 +1,143 @@
+/*
+ * test_policy.cpp
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: Władysław Ostrowski
+ */
+
+/*
+ This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "test.h"
+#include "u8g2_policy.hpp"
+#include <time.h>
+
+/*
+ * IoPolicy<HalSpiBus, BoardPins> against the C transport it replaces
+ * (u8x8_byte_hw_spi with u8x8_gpio_and_delay): both must coalesce the
+ * same way, and the frame time per byte is printed for comparison. The
+ * times are host figures; they show the dispatch overhead, not the bus.
+ */
+
+using Policy = u8g2lib::IoPolicy<u8g2lib::HalSpiBus, u8g2lib::BoardPins>;
+
+static u8g2_t u8g2;
+
+static double ns_per_byte(const unsigned frames)
+{
+  struct timespec t0, t1;
+  clock_gettime(CLOCK_MONOTONIC, &t0);
+  for (unsigned n = 0U; n < frames; n++)
+    u8g2_SendBuffer(&u8g2);
+  clock_gettime(CLOCK_MONOTONIC, &t1);
+  const double ns = (t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec);
+  return ns / (frames * 8.0 * (3 + 128));
+}
+
+static void test_policy_coalesces(void)
+{
+  u8g2_Setup_ssd1306_128x64_noname_f(&u8g2, U8G2_R0, Policy::byte_cb, Policy::gpio_cb);
+  u8x8_hw_spi_init();
+  u8g2_SendBuffer(&u8g2);
+  // one command run and one data run per page, as the C transport
+  CHECK_EQ(mock.spi_drains, 8 * 2);
+  CHECK_EQ(u8x8_stats.transfers, 8);
+  // CS released last, straight through BSRR
+  CHECK_EQ(GPIOA->BSRR, CS_Pin);
+}
+
+static void test_bus_pins(void)
+{
+  u8g2_Setup_ssd1306_128x64_noname_f(&u8g2, U8G2_R0, Policy::byte_cb, Policy::gpio_cb);
+  u8x8_SetPin(u8g2_GetU8x8(&u8g2), U8X8_PIN_CS, U8X8_GPIO_PIN(GPIOB_BASE, 1));
+  u8x8_hw_spi_init();
+  u8g2_SendBuffer(&u8g2);
+  // setBusPins() moved CS to PB1, the board CS on PA4 is left alone
+  CHECK_EQ(GPIOB->BSRR, GPIO_PIN_1);
+  CHECK_EQ(GPIOA->BSRR & (CS_Pin | (CS_Pin << 16)), 0);
+  CHECK_EQ(GPIOA->BSRR, DC_Pin);
+}
+
+static void test_parallel_releases_uarts(void)
+{
+  using Par = u8g2lib::IoPolicy<u8g2lib::BoardI8080Bus, u8g2lib::BoardPins>;
+  u8g2_Setup_ssd1306_128x64_noname_f(&u8g2, U8G2_R0, Par::byte_cb, Par::gpio_cb);
+  u8g2_InitDisplay(&u8g2);
+  // D3/D4 on PA9/PA10 and WR/D7 on PA2/PA15 are the USART1 and USART2 pins
+  CHECK(huart1.Instance == NULL);
+  CHECK(huart2.Instance == NULL);
+  CHECK_EQ(mock.uart_deinits, 2);
+}
+
+// data setup and strobe width come from the display info at the core clock
+static void test_parallel_strobe_timing(void)
+{
+  using Par = u8g2lib::IoPolicy<u8g2lib::BoardI8080Bus, u8g2lib::BoardPins>;
+  u8x8_t *u8x8 = u8g2_GetU8x8(&u8g2);
+  const uint32_t core_hz = SystemCoreClock;
+  uint8_t data[16] = {0};
+  uint32_t t0, t1;
+
+  u8g2_Setup_ssd1306_128x64_noname_f(&u8g2, U8G2_R0, Par::byte_cb, Par::gpio_cb);
+  u8g2_InitDisplay(&u8g2);
+
+  // at 8 MHz a store outlasts both, the bytes go back to back
+  u8x8_cad_StartTransfer(u8x8);
+  t0 = u8x8_cycles();
+  u8x8_cad_SendData(u8x8, sizeof(data), data);
+  t1 = u8x8_cycles();
+  u8x8_cad_EndTransfer(u8x8);
+  CHECK_EQ(t1 - t0, 1);
+
+  SystemCoreClock = 80000000U;
+  u8x8_cad_StartTransfer(u8x8);
+  t0 = u8x8_cycles();
+  u8x8_cad_SendData(u8x8, sizeof(data), data);
+  t1 = u8x8_cycles();
+  const uint32_t last = GPIOA->BSRR;
+  u8x8_cad_EndTransfer(u8x8);
+  SystemCoreClock = core_hz;
+  // per byte the setup time, then the strobe active and inactive for the pulse width
+  const uint32_t setup = (u8x8->display_info->data_setup_time_ns * 80U + 999U) / 1000U;
+  const uint32_t pulse = (u8x8->display_info->write_pulse_width_ns * 80U + 999U) / 1000U;
+  CHECK_EQ(t1 - t0, 1 + sizeof(data) * (setup + 2U * pulse));
+  // the last store of a byte releases WR and leaves the data alone
+  CHECK_EQ(last, PAR_WR_Pin);
+}
+
+static void test_cost_per_byte(void)
+{
+  const unsigned frames = 2000U;
+  double c, p;
+
+  u8g2_Setup_ssd1306_128x64_noname_f(&u8g2, U8G2_R0, u8x8_byte_hw_spi, u8x8_gpio_and_delay);
+  c = ns_per_byte(frames);
+
+  u8g2_Setup_ssd1306_128x64_noname_f(&u8g2, U8G2_R0, Policy::byte_cb, Policy::gpio_cb);
+  p = ns_per_byte(frames);
+
+  CHECK_EQ(mock.spi_drains, 2 * frames * 8 * 2);
+  printf("frame: %.2f ns/byte with u8x8_byte_hw_spi, %.2f ns/byte with IoPolicy (host)\n", c, p);
+}
+
+int main(void)
+{
+  RUN(test_policy_coalesces);
+  RUN(test_bus_pins);
+  RUN(test_parallel_releases_uarts);
+  RUN(test_parallel_strobe_timing);
+  RUN(test_cost_per_byte);
+  return test_report("policy");
+}
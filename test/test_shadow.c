@@ -0,0 +1,125 @@
+/*
+ * test_shadow.c
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: Władysław Ostrowski
+ */
+
+/*
+ This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "test.h"
+
+/*
+ * Controller shadow: page/column commands that repeat what the controller
+ * already has are dropped. After a full-width write the SSD1306 pointer
+ * (horizontal addressing) has wrapped to column 0 of the next page, the
+ * SH1106 one (page addressing) stands at 130 of its 132 on the same page.
+ */
+
+static u8g2_t u8g2;
+static uint32_t cmds;
+static uint8_t cmd[8];
+
+static uint8_t count_cmds(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  static uint8_t dc;
+  const uint8_t *data = (const uint8_t *)arg_ptr;
+  (void)u8x8;
+  if (msg == U8X8_MSG_BYTE_SET_DC)
+    dc = arg_int;
+  else if (msg == U8X8_MSG_BYTE_SEND && dc == 0U)
+  {
+    for (uint8_t i = 0U; i < arg_int; i++, cmds++)
+    {
+      if (cmds < sizeof(cmd))
+        cmd[cmds] = data[i];
+    }
+  }
+  return 1U;
+}
+
+static uint32_t elided_per_frame(void (*setup)(u8g2_t*, const u8g2_cb_t*, u8x8_msg_cb, u8x8_msg_cb), uint8_t columns, uint8_t horizontal)
+{
+  uint32_t before;
+  setup(&u8g2, U8G2_R0, count_cmds, mock_gpio_and_delay);
+  u8x8_shadow_attach(u8g2_GetU8x8(&u8g2), columns, horizontal);
+  u8g2_SendBuffer(&u8g2);  // the shadow learns the controller state
+  before = u8x8_stats.elided;
+  cmds = 0U;
+  u8g2_SendBuffer(&u8g2);
+  CHECK_EQ(cmds + (u8x8_stats.elided - before), 8 * 3);
+  return u8x8_stats.elided - before;
+}
+
+static void test_ssd1306_wraps_to_the_next_page(void)
+{
+  const uint32_t elided = elided_per_frame(u8g2_Setup_ssd1306_128x64_noname_f, 128U, 1U);
+  // each page starts where the previous one left the pointer, page 7 wraps to 0
+  CHECK_EQ(elided, 8 * 3);
+  printf("frame: SSD1306 %u command bytes elided\n", (unsigned)elided);
+}
+
+static void test_sh1106_keeps_column_130(void)
+{
+  const uint32_t elided = elided_per_frame(u8g2_Setup_sh1106_128x64_noname_f, 132U, 0U);
+  // every page has to go back from column 130 to 2, nothing to drop
+  CHECK_EQ(elided, 0);
+  printf("frame: SH1106 %u command bytes elided\n", (unsigned)elided);
+}
+
+static void test_same_tile_twice(void)
+{
+  u8x8_t *u8x8;
+  uint8_t tile[8] = {0};
+  uint32_t before;
+
+  u8g2_Setup_sh1106_128x64_noname_f(&u8g2, U8G2_R0, count_cmds, mock_gpio_and_delay);
+  u8x8 = u8g2_GetU8x8(&u8g2);
+  u8x8_shadow_attach(u8x8, 132U, 0U);
+  u8x8_DrawTile(u8x8, 15U, 2U, 1U, tile);
+  // the pointer stands at 130 after the last tile: the next write there needs only the column
+  before = u8x8_stats.elided;
+  cmds = 0U;
+  u8x8_DrawTile(u8x8, 15U, 2U, 1U, tile);
+  CHECK_EQ(u8x8_stats.elided - before, 1);
+  CHECK_EQ(cmds, 2);
+}
+
+// a write that ends at column 127 leaves the SSD1306 on the next page
+static void test_ssd1306_last_column_changes_page(void)
+{
+  u8x8_t *u8x8;
+  uint8_t tile[8] = {0};
+
+  u8g2_Setup_ssd1306_128x64_noname_f(&u8g2, U8G2_R0, count_cmds, mock_gpio_and_delay);
+  u8x8 = u8g2_GetU8x8(&u8g2);
+  u8x8_shadow_attach(u8x8, 128U, 1U);
+  u8x8_DrawTile(u8x8, 15U, 3U, 1U, tile);
+  // the pointer is at column 0 of page 4, only the page command is needed
+  cmds = 0U;
+  u8x8_DrawTile(u8x8, 0U, 3U, 1U, tile);
+  CHECK_EQ(cmds, 1);
+  CHECK_EQ(cmd[0], 0xB3);
+}
+
+int main(void)
+{
+  RUN(test_ssd1306_wraps_to_the_next_page);
+  RUN(test_ssd1306_last_column_changes_page);
+  RUN(test_sh1106_keeps_column_130);
+  RUN(test_same_tile_twice);
+  return test_report("shadow");
+}
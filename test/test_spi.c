@@ -0,0 +1,113 @@
+/*
+ * test_spi.c
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: Władysław Ostrowski
+ */
+
+/*
+ This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "test.h"
+
+/*
+ * Blocking SPI (INTERFACE::SPI_4W_HW): payloads between DC changes are
+ * coalesced, so the bus is waited for once per DC run and not once per
+ * u8x8 SEND.
+ */
+
+static u8g2_t u8g2;
+static uint32_t sends;
+
+static uint8_t count_sends(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  if (msg == U8X8_MSG_BYTE_SEND)
+    sends++;
+  return u8x8_byte_hw_spi(u8x8, msg, arg_int, arg_ptr);
+}
+
+static void setup(void)
+{
+  u8g2_Setup_ssd1306_128x64_noname_f(&u8g2, U8G2_R0, count_sends, mock_gpio_and_delay);
+  u8x8_hw_spi_init();
+  sends = 0U;
+}
+
+static void test_frame(void)
+{
+  setup();
+  u8g2_SendBuffer(&u8g2);
+  // per page: three addressing commands and the data
+  CHECK_EQ(sends, 8 * 4);
+  // per page: one command run and one data run
+  CHECK_EQ(mock.spi_drains, 8 * 2);
+  CHECK_EQ(u8x8_stats.transfers, 8);
+  CHECK_EQ(u8x8_stats.bytes, 8 * (3 + 128));
+  CHECK(mock.cs == NULL);
+  printf("frame: %u sends, %u bus transactions\n", (unsigned)sends, (unsigned)mock.spi_drains);
+}
+
+static void test_command_args(void)
+{
+  setup();
+  u8g2_SetContrast(&u8g2, 0x40U);
+  CHECK_EQ(sends, 2);
+  CHECK_EQ(mock.spi_drains, 1);
+}
+
+// from inside a critical section the counters leave interrupts off
+static void test_stats_keep_primask(void)
+{
+  u8x8_stats_t stats;
+
+  setup();
+  u8g2_SetContrast(&u8g2, 0x40U);
+  __disable_irq();
+  u8x8_stats_get(&stats);
+  CHECK_EQ(__get_PRIMASK(), 1);
+  u8x8_stats_reset();
+  CHECK_EQ(__get_PRIMASK(), 1);
+  __enable_irq();
+  CHECK_EQ(stats.transfers, 1);
+  CHECK_EQ(u8x8_stats.transfers, 0);
+  u8x8_stats_get(&stats);
+  CHECK_EQ(__get_PRIMASK(), 0);
+}
+
+// an APB2 prescaler change alone moves the SPI1 prescaler
+static void test_clock_follows_pclk2(void)
+{
+  SPI_TypeDef *spi = hspi1.Instance;
+
+  setup();
+  u8g2_SetContrast(&u8g2, 0x40U);
+  CHECK_EQ(spi->CR1 & SPI_CR1_BR, 0U << SPI_CR1_BR_Pos);
+  mock.pclk2 = 10U * u8g2_GetU8x8(&u8g2)->display_info->sck_clock_hz;
+  u8g2_SetContrast(&u8g2, 0x41U);
+  // 10x the panel clock: /16 is the first that keeps SCK at or below it
+  CHECK_EQ(spi->CR1 & SPI_CR1_BR, 3U << SPI_CR1_BR_Pos);
+  mock.pclk2 = 0U;
+  u8g2_SetContrast(&u8g2, 0x42U);
+  CHECK_EQ(spi->CR1 & SPI_CR1_BR, 0U << SPI_CR1_BR_Pos);
+}
+
+int main(void)
+{
+  RUN(test_frame);
+  RUN(test_command_args);
+  RUN(test_stats_keep_primask);
+  RUN(test_clock_follows_pclk2);
+  return test_report("spi");
+}
@@ -0,0 +1,107 @@
+/*
+ * test_spi_3w.c
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: Władysław Ostrowski
+ */
+
+/*
+ This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "test.h"
+
+/*
+ * INTERFACE::SPI_3W_HW: 9-bit frames with DC in bit 8, built in two
+ * buffers of U8X8_3W_BUF_FRAMES that DMA takes turns on.
+ */
+
+static u8g2_t u8g2;
+
+static void setup(void)
+{
+  u8g2_Setup_ssd1306_128x64_noname_f(&u8g2, U8G2_R0, u8x8_byte_hw_spi_3w, mock_gpio_and_delay);
+  mock_run(1U);
+  u8g2_InitDisplay(&u8g2);
+  u8x8_hw_spi_3w_wait();
+  mock_run(0U);
+}
+
+// one page is 3 + 128 frames: DC flips after the addressing and the
+// buffer flips one frame before the end, neither may lose bit 8
+static void test_dc_in_bit_8(void)
+{
+  uint32_t from, starts;
+
+  setup();
+  for (uint16_t n = 0U; n < 128U; n++)
+    u8g2.tile_buf_ptr[n] = (uint8_t)(0xFFU - n);
+  from = mock.wire_len;
+  starts = mock.spi_dma_starts;
+  mock_run(1U);
+  u8x8_DrawTile(u8g2_GetU8x8(&u8g2), 0U, 0U, 16U, u8g2.tile_buf_ptr);
+  u8x8_hw_spi_3w_wait();
+  mock_run(0U);
+
+  CHECK_EQ(mock.wire_len - from, 3 + 128);
+  CHECK_EQ(mock.spi_dma_starts - starts, 2);
+  for (uint32_t i = from; i < from + 3U; i++)
+    CHECK_EQ(mock.wire[i].dc, 0);
+  CHECK_EQ(mock.wire[from + 2U].byte, 0xB0);
+  for (uint16_t n = 0U; n < 128U; n++)
+  {
+    CHECK_EQ(mock.wire[from + 3U + n].dc, 1);
+    CHECK_EQ(mock.wire[from + 3U + n].byte, 0xFF - n);
+  }
+  CHECK(mock.cs == NULL);
+}
+
+// CS goes up from the TX complete interrupt after the hold time
+static void test_cs_hold_from_the_interrupt(void)
+{
+  uint32_t held;
+
+  setup();
+  u8g2_SetContrast(&u8g2, 0x40U);
+  CHECK(u8x8_hw_spi_3w_is_busy());
+  CHECK(mock.cs == u8g2_GetU8x8(&u8g2));
+  held = mock.delay_ns;
+  CHECK(mock_spi_complete());
+  CHECK(mock.cs == NULL);
+  CHECK_EQ(mock.delay_ns - held, u8g2_GetU8x8(&u8g2)->display_info->pre_chip_disable_wait_ns);
+}
+
+// frames the HAL refuses are counted, CS is released right away
+static void test_refused_start(void)
+{
+  uint32_t from;
+
+  setup();
+  from = mock.wire_len;
+  mock.spi_busy = 1U;
+  u8g2_SetContrast(&u8g2, 0x40U);
+  CHECK_EQ(u8x8_stats.errors, 1);
+  CHECK_EQ(mock.wire_len, from);
+  CHECK(!u8x8_hw_spi_3w_is_busy());
+  CHECK(mock.cs == NULL);
+}
+
+int main(void)
+{
+  RUN(test_dc_in_bit_8);
+  RUN(test_cs_hold_from_the_interrupt);
+  RUN(test_refused_start);
+  return test_report("spi_3w");
+}
@@ -0,0 +1,217 @@
+/*
+ * test_spi_dma.c
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: Władysław Ostrowski
+ */
+
+/*
+ This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "test.h"
+#include <string.h>
+
+/*
+ * INTERFACE::SPI_HW_DMA: transfers are queued, the byte callback returns
+ * before anything is on the wire and the DMA interrupt moves on to the
+ * next segment.
+ */
+
+static u8g2_t u8g2;
+
+static void setup(void)
+{
+  u8g2_Setup_ssd1306_128x64_noname_f(&u8g2, U8G2_R0, u8x8_byte_hw_spi_dma, mock_gpio_and_delay);
+}
+
+// one page: column and page commands with DC low, then 128 data bytes
+static void check_page(uint32_t at, uint8_t page, const uint8_t *data)
+{
+  uint8_t cmd = 0U;
+  uint32_t i = at;
+  for (; i < mock.wire_len && mock.wire[i].dc == 0U; i++, cmd++)
+  {
+    CHECK(mock.wire[i].cs == u8g2_GetU8x8(&u8g2));
+    if (mock.wire[i].byte == (0xB0U | page))
+      page = 0xFFU;
+  }
+  CHECK_EQ(cmd, 3);
+  CHECK_EQ(page, 0xFF);
+  for (uint16_t n = 0U; n < 128U; n++, i++)
+  {
+    CHECK_EQ(mock.wire[i].dc, 1);
+    CHECK_EQ(mock.wire[i].byte, data[n]);
+  }
+}
+
+static void test_returns_before_the_wire(void)
+{
+  u8x8_t *u8x8 = u8g2_GetU8x8(&u8g2);
+  uint8_t *row;
+
+  setup();
+  row = u8g2.tile_buf_ptr;
+  for (uint16_t n = 0U; n < 128U; n++)
+    row[n] = (uint8_t)n;
+  u8x8_DrawTile(u8x8, 0U, 0U, 16U, row);
+
+  // only the command segment is on the bus, CS stays asserted
+  CHECK(u8x8_hw_spi_dma_is_busy());
+  CHECK_EQ(mock.spi_dma_starts, 1);
+  CHECK_EQ(mock.wire_len, 3);
+  CHECK(mock.cs == u8x8);
+
+  CHECK(mock_spi_complete());
+  CHECK_EQ(mock.spi_dma_starts, 2);
+  CHECK_EQ(mock.wire_len, 3 + 128);
+  CHECK(mock.cs == u8x8);
+
+  CHECK(mock_spi_complete());
+  CHECK(!u8x8_hw_spi_dma_is_busy());
+  CHECK(mock.cs == NULL);
+  check_page(0U, 0U, row);
+}
+
+// the segments are copies, the caller may reuse its data right away
+static void test_payload_copied(void)
+{
+  u8x8_t *u8x8 = u8g2_GetU8x8(&u8g2);
+  uint8_t cmd[2] = { 0xA5U, 0x81U };
+
+  setup();
+  u8x8_cad_StartTransfer(u8x8);
+  u8x8_cad_SendCmd(u8x8, cmd[0]);
+  u8x8_cad_SendData(u8x8, 2U, cmd);
+  cmd[0] = cmd[1] = 0U;
+  u8x8_cad_EndTransfer(u8x8);
+  while (mock_spi_complete())
+    ;
+  CHECK_EQ(mock.wire_len, 3);
+  CHECK_EQ(mock.wire[0].byte, 0xA5);
+  CHECK_EQ(mock.wire[0].dc, 0);
+  CHECK_EQ(mock.wire[1].byte, 0xA5);
+  CHECK_EQ(mock.wire[2].byte, 0x81);
+  CHECK_EQ(mock.wire[2].dc, 1);
+}
+
+// a whole frame overruns the queue; the interrupt keeps it moving
+static void test_frame(void)
+{
+  setup();
+  for (uint16_t n = 0U; n < 1024U; n++)
+    u8g2.tile_buf_ptr[n] = (uint8_t)(n * 7U);
+  mock_run(1U);
+  u8g2_SendBuffer(&u8g2);
+  u8x8_hw_spi_dma_wait();
+  mock_run(0U);
+
+  CHECK_EQ(mock.wire_len, 8 * (3 + 128));
+  for (uint8_t page = 0U; page < 8U; page++)
+    check_page(page * (3U + 128U), page, u8g2.tile_buf_ptr + page * 128U);
+  CHECK(mock.cs == NULL);
+  CHECK_EQ(u8x8_stats.transfers, 8);
+  CHECK_EQ(u8x8_stats.bytes, 8 * (3 + 128));
+}
+
+// recorded: one queue entry, DC switched between the runs, buffer free on return
+static void test_recorded_frame(void)
+{
+  uint8_t sent[1024];
+  uint32_t ticket;
+
+  setup();
+  for (uint16_t n = 0U; n < 1024U; n++)
+    u8g2.tile_buf_ptr[n] = sent[n] = (uint8_t)(n * 3U);
+  ticket = u8x8_hw_spi_dma_ticket();
+  u8x8_hw_spi_dma_frame_begin();
+  u8g2_SendBuffer(&u8g2);
+  CHECK_EQ(u8x8_hw_spi_dma_frame_end(), ticket + 1U);
+  CHECK_EQ(mock.spi_dma_starts, 1);
+  memset(u8g2.tile_buf_ptr, 0, 1024U);
+
+  while (mock_spi_complete())
+    ;
+  CHECK(!u8x8_hw_spi_dma_is_busy());
+  CHECK_EQ(mock.spi_dma_starts, 8 * 2);
+  CHECK_EQ(mock.wire_len, 8 * (3 + 128));
+  for (uint8_t page = 0U; page < 8U; page++)
+    check_page(page * (3U + 128U), page, sent + page * 128U);
+}
+
+// lent data past U8X8_FRAME_BUF_SIZE is referenced, not sent in pieces
+static void test_lent_frame_past_the_buffer(void)
+{
+  uint32_t ticket;
+
+  setup();
+  for (uint16_t n = 0U; n < 1024U; n++)
+    u8g2.tile_buf_ptr[n] = (uint8_t)(n * 5U);
+  mock_run(1U);
+  ticket = u8x8_hw_spi_dma_ticket();
+  u8x8_hw_spi_dma_frame_begin();
+  u8x8_hw_spi_dma_lend(u8g2.tile_buf_ptr, 1024U);
+  u8g2_SendBuffer(&u8g2);
+  u8g2_SendBuffer(&u8g2);
+  CHECK_EQ(u8x8_hw_spi_dma_frame_end(), ticket + 1U);
+  // the referenced part is out when frame_end() returns
+  CHECK(!u8x8_hw_spi_dma_is_busy());
+  u8x8_hw_spi_dma_lend(NULL, 0U);
+  mock_run(0U);
+
+  CHECK_EQ(mock.wire_len, 2 * 8 * (3 + 128));
+  for (uint8_t page = 0U; page < 16U; page++)
+    check_page(page * (3U + 128U), page & 7U, u8g2.tile_buf_ptr + (page & 7U) * 128U);
+}
+
+// CS goes up from the DMA interrupt after the same hold time as the sync path
+static void test_cs_hold_from_the_interrupt(void)
+{
+  const u8x8_display_info_t *info;
+  uint32_t held;
+
+  setup();
+  info = u8g2_GetU8x8(&u8g2)->display_info;
+  u8x8_DrawTile(u8g2_GetU8x8(&u8g2), 0U, 0U, 16U, u8g2.tile_buf_ptr);
+  CHECK(mock_spi_complete());
+  held = mock.delay_ns;
+  CHECK(mock.cs != NULL);
+  CHECK(mock_spi_complete());
+  CHECK(mock.cs == NULL);
+  CHECK_EQ(mock.delay_ns - held, info->pre_chip_disable_wait_ns);
+}
+
+// a start the HAL refuses drops the run, counts an error and releases CS
+static void test_refused_start(void)
+{
+  setup();
+  mock.spi_busy = 1U;
+  u8x8_DrawTile(u8g2_GetU8x8(&u8g2), 0U, 0U, 16U, u8g2.tile_buf_ptr);
+  CHECK_EQ(u8x8_stats.errors, 2);
+  CHECK_EQ(mock.wire_len, 0);
+  CHECK(!u8x8_hw_spi_dma_is_busy());
+  CHECK(mock.cs == NULL);
+}
+
+int main(void)
+{
+  RUN(test_returns_before_the_wire);
+  RUN(test_payload_copied);
+  RUN(test_frame);
+  RUN(test_recorded_frame);
+  RUN(test_lent_frame_past_the_buffer);
+  RUN(test_cs_hold_from_the_interrupt);
+  RUN(test_refused_start);
+  return test_report("spi_dma");
+}
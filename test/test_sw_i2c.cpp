@@ -0,0 +1,171 @@
+/*
+ * test_sw_i2c.cpp
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: Władysław Ostrowski
+ */
+
+/*
+ This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "test.h"
+#include "u8g2_policy.hpp"
+#include <string.h>
+
+/*
+ * SwI2cBus (the I2C_SW transport) against a slave played from the DWT
+ * hook: every wait of the bus reads the cycle counter, so the hook sees
+ * each BSRR store that is held for half a bit. The SCL low stores between
+ * bits are not held and not seen; a bit is the SDA level at an SCL
+ * release. The slave answers the ninth clock of each byte by pulling SDA
+ * low in IDR.
+ */
+
+using Bus = u8g2lib::BoardSwI2cBus;
+
+static const uint32_t SCL = SWI2C_SCL_Pin;
+static const uint32_t SDA = SWI2C_SDA_Pin;
+
+static u8x8_t u8x8;
+
+static struct
+{
+  uint32_t bsrr;      // the store seen last
+  uint8_t sda;        // as the master drives it
+  uint8_t acks;       // 0: the slave stays silent
+  uint32_t clocks;
+  uint8_t bit[64];    // SDA at each SCL release
+} line;
+
+static void slave(void)
+{
+  const uint32_t bsrr = GPIOB->BSRR;
+
+  if (bsrr == line.bsrr)
+    return;
+  line.bsrr = bsrr;
+  GPIOB->IDR |= SDA;  // any ACK ends with the clock it answered
+  if (bsrr & (SDA << 16))
+    line.sda = 0U;
+  if (bsrr & SDA)
+    line.sda = 1U;
+  if (bsrr & SCL)
+  {
+    if (line.clocks < sizeof(line.bit))
+      line.bit[line.clocks] = line.sda;
+    // the first release belongs to START, then nine per byte
+    if (line.acks && line.clocks > 0U && line.clocks % 9U == 0U)
+      GPIOB->IDR &= ~SDA;
+    line.clocks++;
+  }
+}
+
+static void setup(void)
+{
+  memset(&line, 0, sizeof(line));
+  line.acks = 1U;
+  u8x8_SetI2CAddress(&u8x8, 0x78U);
+  Bus::init(&u8x8);
+  line.bsrr = GPIOB->BSRR;  // idle, both released
+  line.sda = 1U;
+  GPIOB->IDR = SCL | SDA;  // both pulled up
+  mock.dwt = slave;
+}
+
+// the eight bits of clock 1 + 9 * byte + 1 ..., MSB first
+static uint8_t byte_at(const uint32_t byte)
+{
+  uint8_t b = 0U;
+  for (uint32_t n = 0U; n < 8U; n++)
+    b = (uint8_t)(b << 1 | line.bit[1U + 9U * byte + n]);
+  return b;
+}
+
+static void test_address_and_data(void)
+{
+  static const uint8_t data[] = {0x00U, 0xAFU};
+
+  setup();
+  Bus::start(&u8x8);
+  Bus::send(&u8x8, data, sizeof(data));
+  Bus::flush();
+
+  // START, three bytes of nine clocks, STOP
+  CHECK_EQ(line.clocks, 1 + 3 * 9 + 1);
+  CHECK_EQ(byte_at(0U), 0x78);
+  CHECK_EQ(byte_at(1U), 0x00);
+  CHECK_EQ(byte_at(2U), 0xAF);
+  // the master lets SDA go for the ACK clock
+  CHECK_EQ(line.bit[9], 1);
+  CHECK_EQ(line.bit[18], 1);
+  CHECK_EQ(line.bit[27], 1);
+  // STOP: SCL up with SDA low, then SDA up
+  CHECK_EQ(line.bit[28], 0);
+  CHECK_EQ(GPIOB->BSRR, SDA);
+  CHECK_EQ(u8x8_stats.errors, 0);
+  CHECK_EQ(u8x8_stats.timeouts, 0);
+}
+
+static void test_nack_drops_the_transfer(void)
+{
+  static const uint8_t data[] = {0x00U, 0xAFU};
+
+  setup();
+  line.acks = 0U;
+  Bus::start(&u8x8);
+  Bus::send(&u8x8, data, sizeof(data));
+  Bus::flush();
+
+  // the address only, STOP still goes out
+  CHECK_EQ(line.clocks, 1 + 9 + 1);
+  CHECK_EQ(byte_at(0U), 0x78);
+  CHECK_EQ(GPIOB->BSRR, SDA);
+  CHECK_EQ(u8x8_stats.errors, 1);
+  CHECK_EQ(u8x8_stats.timeouts, 0);
+}
+
+static void test_scl_held_low(void)
+{
+  static const uint8_t data[] = {0x00U, 0xAFU};
+
+  setup();
+  GPIOB->IDR = SDA;
+  Bus::start(&u8x8);
+  Bus::send(&u8x8, data, sizeof(data));
+  // no bit is clocked after START gave up
+  CHECK_EQ(line.clocks, 1);
+  CHECK_EQ(u8x8_stats.timeouts, 1);
+  Bus::flush();
+  CHECK_EQ(u8x8_stats.timeouts, 2);
+  CHECK_EQ(u8x8_stats.errors, 0);
+
+  // the slave lets go, the next transfer goes through
+  GPIOB->IDR = SCL | SDA;
+  line.clocks = 0U;
+  Bus::start(&u8x8);
+  Bus::send(&u8x8, data, sizeof(data));
+  Bus::flush();
+  CHECK_EQ(line.clocks, 1 + 3 * 9 + 1);
+  CHECK_EQ(u8x8_stats.timeouts, 2);
+}
+
+int main(void)
+{
+  RUN(test_address_and_data);
+  RUN(test_nack_drops_the_transfer);
+  RUN(test_scl_held_low);
+  return test_report("sw_i2c");
+}
@@ -0,0 +1,312 @@
+/*
+ * test_u8g2lib.cpp
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: Władysław Ostrowski
+ */
+
+/*
+ This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "test.h"
+#include "u8g2lib.hpp"
+#include <string.h>
+
+/*
+ * The U8G2 class against the mock HAL: what its page loops, boot state
+ * machine and controller commands put on the wire. The display objects
+ * are the specializations of lib/u8g2/u8g2lib.cpp.
+ */
+
+using namespace u8g2lib;
+
+using PipelinedOled = U8G2<CHIP_TYPE::SSD1306, INTERFACE::SPI_HW_DMA, DISPLAY::NONAME_128x64, MODE::PIPELINED_PAGE>;
+using PagedOled = U8G2<CHIP_TYPE::SSD1306, INTERFACE::SPI_HW_DMA, DISPLAY::NONAME_128x64, MODE::FULL_PAGE>;
+using SignedOled = U8G2<CHIP_TYPE::SSD1306, INTERFACE::SPI_HW_DMA, DISPLAY::NONAME_128x64, MODE::SIGNED_PAGE>;
+using BufferedOled = U8G2<CHIP_TYPE::SSD1306, INTERFACE::I2C_HW, DISPLAY::NONAME_128x64, MODE::FULL_BUFFER>;
+
+// the gpio callback the mock can see CS and DC through
+template<typename T> static void watch(T &display)
+{
+  display.getU8x8()->gpio_and_delay_cb = mock_gpio_and_delay;
+}
+
+static uint32_t data_bytes(uint32_t from)
+{
+  uint32_t n = 0U;
+  for (; from < mock.wire_len; from++)
+    n += mock.wire[from].dc;
+  return n;
+}
+
+static void test_pipelined_pages(void)
+{
+  static PipelinedOled oled(U8G2_R0);
+  uint8_t *half[8];
+  uint8_t row = 0U;
+
+  watch(oled);
+  mock_run(1U);
+  oled.begin();
+  oled.waitForTransfer();
+  const uint32_t from = mock.wire_len;
+
+  oled.firstPage();
+  do
+  {
+    half[row] = oled.getBufferPtr();
+    // the half handed out again is the one of two pages back: its ticket
+    // was waited for, so all of that page is on the wire already
+    if(row >= 2U)
+    {
+      CHECK(data_bytes(from) >= (row - 1U) * 128U);
+    }
+    memset(half[row], 0x11 * (row + 1), 128U);
+    row++;
+  } while(oled.nextPage());
+  oled.waitForTransfer();
+  mock_run(0U);
+
+  CHECK_EQ(row, 8);
+  CHECK(half[0] != half[1]);
+  for(uint8_t r = 2U; r < 8U; r++)
+  {
+    CHECK(half[r] == half[r & 1U]);
+  }
+
+  // every page sent in turn with what was drawn into it; only page 0 is
+  // addressed, from there the SSD1306 pointer walks the pages by itself
+  uint32_t n = 0U;
+  for(uint32_t i = from; i < mock.wire_len; i++)
+  {
+    if(mock.wire[i].dc != 0U)
+    {
+      CHECK_EQ(mock.wire[i].byte, 0x11 * (n / 128U + 1U));
+      n++;
+    }
+  }
+  CHECK_EQ(n, 8 * 128);
+  CHECK_EQ(wire_find(from, 1U), from + 3);
+  CHECK_EQ(mock.wire_len - from, 3 + n);
+  CHECK_EQ(oled.getFrameStats().pages, 8);
+}
+
+static uint32_t readyCalls;
+
+static void onReady()
+{
+  readyCalls++;
+}
+
+// RST is driven through BSRR, the last write tells the level
+static bool resetHigh()
+{
+  return GPIOA->BSRR == RST_Pin;
+}
+
+static bool resetLow()
+{
+  return GPIOA->BSRR == (RST_Pin << 16);
+}
+
+static void test_async_boot(void)
+{
+  static PagedOled oled(U8G2_R0);
+  const auto *info = oled.getU8x8()->display_info;
+
+  readyCalls = 0U;
+  oled.beginAsync(onReady);
+  CHECK(resetHigh());
+  CHECK(!oled.isReady());
+
+  // each phase ends on the first poll after its time has passed
+  mock.tick += info->reset_pulse_width_ms;
+  CHECK(!oled.pollBegin());
+  CHECK(resetHigh());
+  mock.tick++;
+  CHECK(!oled.pollBegin());
+  CHECK(resetLow());
+
+  mock.tick += info->reset_pulse_width_ms;
+  oled.pollBegin();
+  CHECK(resetLow());
+  mock.tick++;
+  oled.pollBegin();
+  CHECK(resetHigh());
+
+  mock.tick += info->post_reset_wait_ms;
+  oled.pollBegin();
+  CHECK_EQ(mock.wire_len, 0);
+  mock.tick++;
+  CHECK(!oled.pollBegin());
+
+  // init, clear and power-on recorded into one frame, streaming now
+  CHECK(mock.wire_len > 0U);
+  CHECK(u8x8_hw_spi_dma_is_busy());
+  CHECK(!oled.pollBegin());
+  CHECK_EQ(readyCalls, 0);
+  while(mock_spi_complete())
+  {
+  }
+  CHECK(oled.pollBegin());
+  CHECK(oled.isReady());
+  CHECK_EQ(readyCalls, 1);
+  CHECK(oled.pollBegin());
+  CHECK_EQ(readyCalls, 1);
+
+  // display off first, the cleared RAM, power-on last
+  CHECK_EQ(mock.wire[0].byte, 0xAE);
+  CHECK(mock.wire_len > 8U * 128U);
+  CHECK_EQ(mock.wire[mock.wire_len - 1U].byte, 0xAF);
+  CHECK(oled.getU8x8()->gpio_and_delay_cb == PagedOled::IO::gpio_cb);
+}
+
+// page row drawn as 0x11 * (row + 1), except page changed drawn as value
+static void signed_frame(SignedOled &oled, const uint8_t changed, const uint8_t value)
+{
+  oled.firstPage();
+  do
+  {
+    const uint8_t row = u8g2_GetBufferCurrTileRow(oled.getU8g2());
+    memset(oled.getBufferPtr(), row == changed ? value : 0x11 * (row + 1), 128U);
+  } while(oled.nextPage());
+  oled.waitForTransfer();
+}
+
+static void test_signed_pages(void)
+{
+  static SignedOled oled(U8G2_R0);
+  uint32_t from;
+
+  watch(oled);
+  mock_run(1U);
+  oled.begin();
+  oled.waitForTransfer();
+
+  // no signatures yet: every page
+  from = mock.wire_len;
+  signed_frame(oled, 0xFFU, 0U);
+  CHECK_EQ(data_bytes(from), 8 * 128);
+
+  // the same frame again: nothing
+  from = mock.wire_len;
+  signed_frame(oled, 0xFFU, 0U);
+  CHECK_EQ(data_bytes(from), 0);
+
+  // one page changed: that page alone, addressed to its row
+  from = mock.wire_len;
+  signed_frame(oled, 5U, 0xA5U);
+  CHECK_EQ(data_bytes(from), 128);
+  for (uint32_t i = from; i < mock.wire_len; i++)
+  {
+    if (mock.wire[i].dc != 0U)
+      CHECK_EQ(mock.wire[i].byte, 0xA5);
+  }
+  const uint32_t data = wire_find(from, 1U);
+  bool addressed = false;
+  for (uint32_t i = from; i < data; i++)
+    addressed = addressed || mock.wire[i].byte == (0xB0 | 5);
+  CHECK(addressed);
+
+  // the controller RAM was cleared behind the signatures: every page again
+  oled.clearDisplay();
+  oled.waitForTransfer();
+  from = mock.wire_len;
+  signed_frame(oled, 5U, 0xA5U);
+  mock_run(0U);
+  CHECK_EQ(data_bytes(from), 8 * 128);
+}
+
+// the payload of the I2C writes from write from on that start with control
+// byte ctrl (0x00 commands, 0x40 data), joined into out
+static uint32_t i2c_bytes(uint32_t from, const uint8_t ctrl, uint8_t *out, const uint32_t size)
+{
+  uint32_t n = 0U;
+  for (; from < mock.i2c_len; from++)
+  {
+    const mock_i2c_t *w = &mock.i2c[from];
+    if (w->len == 0U || w->data[0] != ctrl)
+      continue;
+    for (uint16_t i = 1U; i < w->len && n < size; i++)
+      out[n++] = w->data[i];
+  }
+  return n;
+}
+
+static void test_scroll_commands(void)
+{
+  static BufferedOled oled(U8G2_R0);
+  uint8_t cmd[32];
+  static uint8_t data[8U * 128U];
+
+  mock_run(1U);
+  oled.begin();
+  oled.waitForTransfer();
+
+  // the start line wraps both ways
+  mock.i2c_len = 0U;
+  oled.scrollVertical(8);
+  oled.scrollVertical(-16);
+  oled.waitForTransfer();
+  CHECK_EQ(i2c_bytes(0U, 0x00U, cmd, sizeof(cmd)), 2);
+  CHECK_EQ(cmd[0], 0x40 | 8);
+  CHECK_EQ(cmd[1], 0x40 | 56);
+  CHECK_EQ(oled.bufferRow(0U), 56);
+  CHECK_EQ(oled.bufferRow(8U), 0);
+  CHECK_EQ(i2c_bytes(0U, 0x40U, data, sizeof(data)), 0);
+
+  // setup and activate in one go; a running scroll is stopped first
+  static const uint8_t left[] = {0x27, 0x00, 2, 7, 5, 0x00, 0xFF, 0x2F};
+  static const uint8_t right[] = {0x2E, 0x26, 0x00, 0, 4, 7, 0x00, 0xFF, 0x2F};
+  mock.i2c_len = 0U;
+  oled.scrollHorizontal(true, 2U, 5U);
+  oled.waitForTransfer();
+  CHECK_EQ(i2c_bytes(0U, 0x00U, cmd, sizeof(cmd)), sizeof(left));
+  CHECK(memcmp(cmd, left, sizeof(left)) == 0);
+  mock.i2c_len = 0U;
+  oled.scrollHorizontal(false, 0U, 7U, 4U);
+  oled.waitForTransfer();
+  CHECK_EQ(i2c_bytes(0U, 0x00U, cmd, sizeof(cmd)), sizeof(right));
+  CHECK(memcmp(cmd, right, sizeof(right)) == 0);
+
+  // deactivate, then the buffer goes back on the scrolled pages
+  uint8_t *buf = oled.getBufferPtr();
+  for (uint16_t n = 0U; n < 8U * 128U; n++)
+    buf[n] = (uint8_t)(n * 3U);
+  mock.i2c_len = 0U;
+  oled.stopScroll();
+  oled.waitForTransfer();
+  CHECK(i2c_bytes(0U, 0x00U, cmd, sizeof(cmd)) > 1U);
+  CHECK_EQ(cmd[0], 0x2E);
+  CHECK_EQ(i2c_bytes(0U, 0x40U, data, sizeof(data)), 8 * 128);
+  CHECK(memcmp(data, buf, sizeof(data)) == 0);
+
+  // nothing to stop
+  mock.i2c_len = 0U;
+  oled.stopScroll();
+  oled.waitForTransfer();
+  mock_run(0U);
+  CHECK_EQ(mock.i2c_len, 0);
+}
+
+int main(void)
+{
+  RUN(test_pipelined_pages);
+  RUN(test_async_boot);
+  RUN(test_signed_pages);
+  RUN(test_scroll_commands);
+  return test_report("u8g2lib");
+}